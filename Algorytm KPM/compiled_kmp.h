@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @brief Skompilowany wzorzec KMP - tablica przejść liczona raz, wyszukiwanie bez wypisywania.
+ *
+ * computeLPSArray i KMPSearchSteps z main_KPM.cpp wypisują stan w każdym kroku
+ * (printMatchState drukuje cały tekst), więc nadają się tylko do ilustracji.
+ * \ref CompiledKMP przygotowuje wzorzec raz i przeszukuje nim dowolnie wiele tekstów:
+ * - dla małych alfabetów wzorzec zamieniany jest w automat (zwarta tablica DFA
+ *   z compact_dfa.h, jeśli mieści się w L1) - jeden odczyt tablicy na znak, bez cofania,
+ * - w pozostałych przypadkach używana jest "silna" funkcja porażki Knutha: przy
+ *   niedopasowaniu nigdy nie cofamy się do pozycji z tym samym znakiem, który właśnie
+ *   nie pasował, więc pętla cofania wykonuje się rzadziej niż z samą tablicą LPS.
+ *
+ * Śledzenie kroków jest opcją czasu kompilacji: search() z obiektem śledzącym
+ * (np. wypisującym stan jak printMatchState) używa klasycznej pętli KMP i wywołuje go
+ * w każdym kroku; bez niego kod śledzenia w ogóle nie jest generowany.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "../wyszukaj_wzorzec/automat_wyszukiwanie_wzorca/compact_dfa.h"
+
+/**
+ * @brief Brak śledzenia - domyślny parametr CompiledKMP::search.
+ */
+struct NoKMPTrace {
+    void operator()(size_t, size_t) const {}
+};
+
+/**
+ * @brief Wzorzec przygotowany do wyszukiwania algorytmem KMP.
+ */
+class CompiledKMP {
+public:
+    /**
+     * @brief Sposób wyszukiwania: automatyczny wybór, zawsze funkcja porażki lub zawsze DFA.
+     */
+    enum class Engine { Auto, FailureFunction, DFA };
+
+private:
+    static constexpr size_t MAX_DFA_BYTES = 32 * 1024; ///< Automat tylko jeśli mieści się w L1
+
+    std::string pattern;
+    std::vector<int> lps;    ///< Tablica LPS jak w computeLPSArray
+    std::vector<int> strong; ///< Silna funkcja porażki; -1 - przesuń się w tekście
+    std::optional<CompactDFA> dfa;
+
+    static size_t dfaBytes(std::string_view pattern) {
+        bool used[256] = {false};
+        size_t distinct = 0;
+        for (char ch : pattern) {
+            if (!used[(unsigned char)ch]) {
+                used[(unsigned char)ch] = true;
+                distinct++;
+            }
+        }
+        size_t classes = distinct < 256 ? distinct + 1 : 256;
+        size_t stateBytes = pattern.size() < UINT8_MAX ? 1 : pattern.size() < UINT16_MAX ? 2 : 4;
+        return (pattern.size() + 1) * classes * stateBytes;
+    }
+
+public:
+    explicit CompiledKMP(std::string_view patternText, Engine engine = Engine::Auto)
+        : pattern(patternText), lps(pattern.size()), strong(pattern.size()) {
+        size_t m = pattern.size();
+        // Tablica LPS - ta sama pętla co w computeLPSArray, bez wypisywania
+        size_t length = 0;
+        for (size_t i = 1; i < m;) {
+            if (pattern[i] == pattern[length]) {
+                lps[i++] = (int)++length;
+            } else if (length != 0) {
+                length = lps[length - 1];
+            } else {
+                lps[i++] = 0;
+            }
+        }
+        // strong[j]: dokąd cofnąć się po niedopasowaniu na pozycji j. Jeśli cel ma ten sam
+        // znak co pozycja j, niedopasowanie też by się powtórzyło - przeskakujemy go od razu.
+        for (size_t j = 0; j < m; j++) {
+            int k = j == 0 ? -1 : lps[j - 1];
+            strong[j] = k >= 0 && pattern[k] == pattern[j] ? strong[k] : k;
+        }
+        if (m > 0 && (engine == Engine::DFA || (engine == Engine::Auto && autoUsesDFA(pattern)))) {
+            dfa.emplace(pattern);
+        }
+    }
+
+    /**
+     * @brief Wyszukuje wszystkie wystąpienia wzorca.
+     *
+     * @param text     Tekst, w którym szukamy
+     * @param onMatch  Wywoływane z pozycją każdego dopasowania, w kolejności rosnącej
+     * @param trace    Opcjonalnie: wywoływane jako trace(i, j) po każdym kroku klasycznej
+     *                 pętli KMP (i - indeks w tekście, j - liczba dopasowanych znaków)
+     */
+    template <typename OnMatch, typename Trace = NoKMPTrace>
+    void search(std::string_view text, OnMatch onMatch, Trace trace = Trace()) const {
+        int m = (int)pattern.size();
+        if (m == 0) {
+            return;
+        }
+        if constexpr (!std::is_same_v<Trace, NoKMPTrace>) {
+            // Klasyczna pętla z KMPSearchSteps, żeby kroki odpowiadały ilustracji
+            size_t i = 0;
+            int j = 0;
+            KMPProbe probe;
+            trace(i, (size_t)j);
+            while (i < text.size()) {
+                if (text[i] == pattern[j]) {
+                    probe.character();
+                    i++;
+                    j++;
+                    if (j == m) {
+                        probe.match();
+                        onMatch(i - m);
+                        j = lps[j - 1];
+                    }
+                } else if (j != 0) {
+                    probe.fallback();
+                    j = lps[j - 1];
+                } else {
+                    probe.character();
+                    i++;
+                }
+                trace(i, (size_t)j);
+            }
+        } else if (dfa) {
+            dfa->search(text, onMatch);
+        } else {
+            const char* p = pattern.data();
+            const int* next = strong.data();
+            int j = 0;
+            KMPProbe probe;
+            for (size_t i = 0; i < text.size(); i++) {
+                char c = text[i];
+                probe.character();
+                while (j >= 0 && p[j] != c) {
+                    probe.fallback();
+                    j = next[j];
+                }
+                if (++j == m) {
+                    probe.match();
+                    onMatch(i + 1 - m);
+                    j = lps[m - 1];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Zlicza wystąpienia wzorca.
+     */
+    size_t count(std::string_view text) const {
+        if (dfa) {
+            return dfa->count(text);
+        }
+        size_t found = 0;
+        search(text, [&](size_t) { found++; });
+        return found;
+    }
+
+    bool usesDFA() const { return dfa.has_value(); }
+
+    /**
+     * @brief Czy Engine::Auto zbudowałby automat dla tego wzorca - bez budowania czegokolwiek.
+     */
+    static bool autoUsesDFA(std::string_view pattern) {
+        return !pattern.empty() && dfaBytes(pattern) <= MAX_DFA_BYTES;
+    }
+
+    const std::vector<int>& lpsTable() const { return lps; }
+};
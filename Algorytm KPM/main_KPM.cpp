@@ -1,5 +1,7 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include "compiled_kmp.h"
 
 using namespace std;
 
@@ -163,6 +165,26 @@ void KMPSearchSteps(const string &text, const string &pattern, int *lps) {
     }
 }
 
+/**
+ * @brief Wyszukuje wzorzec w wielu tekstach jednym skompilowanym obiektem KMP.
+ *
+ * Tablica przejść liczona jest raz (\ref CompiledKMP), a wyszukiwanie nie wypisuje
+ * niczego w trakcie - wypisywane są tylko znalezione pozycje.
+ *
+ * @param pattern   Wzorzec
+ * @param texts     Teksty, w których szukamy
+ */
+void compiledKMPSearch(const string &pattern, const vector<string> &texts) {
+    CompiledKMP compiled(pattern);
+    cout << "CompiledKMP dla wzorca " << pattern << " ("
+         << (compiled.usesDFA() ? "automat DFA" : "silna funkcja porazki") << "):\n";
+    for (const string &text : texts) {
+        cout << "Tekst: " << text << " - dopasowania na pozycjach:";
+        compiled.search(text, [](size_t position) { cout << " " << position; });
+        cout << "\n";
+    }
+}
+
 /**
  * @brief Funkcja główna programu – demonstruje działanie algorytmu KMP.
  *
@@ -171,23 +193,33 @@ void KMPSearchSteps(const string &text, const string &pattern, int *lps) {
  * 2. Alokowana jest tablica \p lps o rozmiarze równym długości wzorca,
  * 3. Wywoływana jest funkcja \ref computeLPSArray w celu obliczenia tablicy LPS,
  * 4. Wywoływana jest funkcja \ref KMPSearchSteps, aby pokazać kolejne kroki wyszukiwania,
- * 5. Zwalniana jest pamięć tablicy \p lps.
+ * 5. Zwalniana jest pamięć tablicy \p lps,
+ * 6. Ten sam wzorzec wyszukiwany jest w kilku tekstach przez \ref compiledKMPSearch.
+ *
+ * Z opcją `--bez-krokow` kroki 2-5 są pomijane (wizualizacja drukuje cały tekst
+ * w każdym kroku, więc dla dłuższych tekstów jej wynik rośnie kwadratowo).
  *
  * @return Kod zakończenia programu (0 oznacza sukces).
  */
-int main() {
+int main(int argc, char *argv[]) {
     string text = "bacbabbaabab";   // Tekst, w którym szukamy
     string pattern = "ababbabca";   // Wzorzec do znalezienia
+    bool showSteps = !(argc > 1 && string(argv[1]) == "--bez-krokow");
 
-    int m = (int)pattern.size();
-    int *lps = new int[m];
+    if (showSteps) {
+        int m = (int)pattern.size();
+        int *lps = new int[m];
 
-    // Obliczanie tablicy LPS krok po kroku
-    computeLPSArray(pattern, lps);
+        // Obliczanie tablicy LPS krok po kroku
+        computeLPSArray(pattern, lps);
 
-    // Wyswietlanie krokow dopasowywania wzorca
-    KMPSearchSteps(text, pattern, lps);
+        // Wyswietlanie krokow dopasowywania wzorca
+        KMPSearchSteps(text, pattern, lps);
+
+        delete[] lps;
+    }
 
-    delete[] lps;
+    // Wzorzec przygotowany raz, wyszukiwanie bez wypisywania kroków
+    compiledKMPSearch("abab", {text, "ababababab", "abba"});
     return 0;
 }
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Bump allocator: memory is handed out from large chunks and released only all at once.
+// An allocation is a pointer increment and the destructor costs O(number of chunks).
+class Arena {
+private:
+    struct Chunk {
+        Chunk* next;
+    };
+
+    static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    Chunk* chunks; // Most recent chunk first
+    char* cursor;  // Next free byte in the current chunk
+    char* end;     // One past the last byte of the current chunk
+    size_t chunkSize;
+    size_t chunkCount;
+
+    static uintptr_t alignUp(uintptr_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    void addChunk(size_t minBytes) {
+        size_t bytes = sizeof(Chunk) + minBytes;
+        if (bytes < chunkSize) {
+            bytes = chunkSize;
+        }
+        Chunk* chunk = (Chunk*)std::malloc(bytes);
+        if (!chunk) {
+            throw std::bad_alloc();
+        }
+        chunk->next = chunks;
+        chunks = chunk;
+        cursor = (char*)(chunk + 1);
+        end = (char*)chunk + bytes;
+        chunkCount++;
+    }
+
+public:
+    Arena(size_t chunkBytes = DEFAULT_CHUNK_SIZE)
+        : chunks(nullptr), cursor(nullptr), end(nullptr), chunkSize(chunkBytes), chunkCount(0) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        while (chunks) {
+            Chunk* next = chunks->next;
+            std::free(chunks);
+            chunks = next;
+        }
+    }
+
+    void* allocate(size_t bytes, size_t alignment) {
+        uintptr_t result = alignUp((uintptr_t)cursor, alignment);
+        if (!cursor || result + bytes > (uintptr_t)end) {
+            addChunk(bytes + alignment);
+            result = alignUp((uintptr_t)cursor, alignment);
+        }
+        cursor = (char*)(result + bytes);
+        return (void*)result;
+    }
+
+    // Make sure the next `bytes` bytes are served without another malloc
+    void reserve(size_t bytes) {
+        if (!cursor || (size_t)(end - cursor) < bytes) {
+            addChunk(bytes);
+        }
+    }
+
+    size_t chunksAllocated() const { return chunkCount; }
+};
+
+// Fixed-size object pool on top of an Arena. Released objects go to a free list and are
+// reused by the next allocate(); their memory returns to the system with the arena.
+// T must be trivially destructible, because the arena never runs destructors.
+template <typename T>
+class ObjectPool {
+private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    static_assert(sizeof(T) >= sizeof(FreeSlot), "object too small for the free list");
+
+    Arena& arena;
+    FreeSlot* freeList;
+
+public:
+    ObjectPool(Arena& source) : arena(source), freeList(nullptr) {}
+
+    void* allocate() {
+        if (freeList) {
+            FreeSlot* slot = freeList;
+            freeList = slot->next;
+            return slot;
+        }
+        return arena.allocate(sizeof(T), alignof(T));
+    }
+
+    void release(T* object) {
+        FreeSlot* slot = (FreeSlot*)object;
+        slot->next = freeList;
+        freeList = slot;
+    }
+};
+
+// Append-only storage for key bytes on top of an Arena
+class StringSlab {
+private:
+    Arena& arena;
+
+public:
+    StringSlab(Arena& source) : arena(source) {}
+
+    // Copy the bytes into the slab; the result is not null-terminated
+    const char* store(const char* data, size_t length) {
+        char* result = (char*)arena.allocate(length ? length : 1, 1);
+        memcpy(result, data, length);
+        return result;
+    }
+};
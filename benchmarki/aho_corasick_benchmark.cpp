@@ -0,0 +1,73 @@
+// Benchmark: AhoCorasick (one pass) vs MultiPatternRabinKarp vs one simdSearch pass per pattern.
+// Usage: ./aho_corasick_benchmark [text_megabytes] [number_of_patterns] [max_pattern_length]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../wyszukaj_wzorzec/aho_corasick.h"
+#include "../wyszukaj_wzorzec/rabin_karp.h"
+#include "../wyszukaj_wzorzec/simd_search.h"
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 16;
+    int patternCount = argc > 2 ? atoi(argv[2]) : 1000;
+    int maxLength = argc > 3 ? atoi(argv[3]) : 12;
+
+    mt19937 rng(7);
+    uniform_int_distribution<int> letter('a', 'z');
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = (char)letter(rng);
+    }
+    // Patterns of mixed lengths 4..maxLength, half of them taken from the text
+    vector<string> patterns;
+    uniform_int_distribution<int> length(4, maxLength);
+    uniform_int_distribution<size_t> offset(0, text.size() - maxLength);
+    for (int i = 0; i < patternCount; i++) {
+        if (i % 2 == 0) {
+            patterns.push_back(text.substr(offset(rng), length(rng)));
+        } else {
+            string pattern(length(rng), ' ');
+            for (char& ch : pattern) ch = (char)letter(rng);
+            patterns.push_back(pattern);
+        }
+    }
+
+    size_t acMatches = 0;
+    auto start = chrono::steady_clock::now();
+    AhoCorasick automaton(patterns);
+    double buildSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    automaton.search(text, [&](size_t, size_t) { acMatches++; });
+    double acSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    size_t rkMatches = 0;
+    start = chrono::steady_clock::now();
+    MultiPatternRabinKarp matcher(patterns);
+    matcher.search(text, [&](size_t, size_t) { rkMatches++; });
+    double rkSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // One pass per pattern: measure a sample of passes and extrapolate
+    int sample = patternCount < 50 ? patternCount : 50;
+    size_t sampleMatches = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < sample; i++) {
+        simdSearch(text, patterns[i], [&](size_t) { sampleMatches++; });
+    }
+    double loopSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() *
+                         patternCount / sample;
+
+    cout << "Tekst: " << megabytes << " MB, wzorce: " << patternCount << " x 4.." << maxLength
+         << " znakow\n";
+    cout << "AhoCorasick: " << automaton.stateCount() << " stanow, "
+         << automaton.memoryBytes() / 1024 << " KB, budowa " << buildSeconds << " s\n";
+    cout << "AhoCorasick (1 przejscie): " << acSeconds << " s, " << text.size() / acSeconds / 1e6
+         << " MB/s, dopasowania: " << acMatches << "\n";
+    cout << "MultiPatternRabinKarp (1 przejscie): " << rkSeconds << " s, "
+         << text.size() / rkSeconds / 1e6 << " MB/s, dopasowania: " << rkMatches << "\n";
+    cout << "simdSearch w petli (" << patternCount << " przejsc, oszacowane z " << sample
+         << "): " << loopSeconds << " s, dopasowania w probce: " << sampleMatches << "\n";
+    return 0;
+}
@@ -0,0 +1,53 @@
+// Benchmark: HashTable::searchBatch vs a loop of single search calls.
+// Usage: ./batch_search_benchmark [number_of_keys] [number_of_queries]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../hash_table.h"
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int keyCount = argc > 1 ? atoi(argv[1]) : 1000000;
+    int queryCount = argc > 2 ? atoi(argv[2]) : 1000000;
+
+    HashTable<WyHash> table(13);
+    table.reserve(keyCount);
+    for (int i = 0; i < keyCount; i++) {
+        table.insert("imie_" + to_string(i));
+    }
+
+    // Half hits, half misses, in random order
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, 2 * keyCount - 1);
+    vector<string> queries;
+    queries.reserve(queryCount);
+    for (int i = 0; i < queryCount; i++) {
+        queries.push_back("imie_" + to_string(pick(rng)));
+    }
+    vector<string_view> views(queries.begin(), queries.end());
+
+    auto start = chrono::steady_clock::now();
+    size_t foundSingle = 0;
+    for (const string& query : queries) {
+        foundSingle += table.search(query);
+    }
+    double singleNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+    bool* results = new bool[queryCount];
+    start = chrono::steady_clock::now();
+    size_t foundBatch = table.searchBatch(views, span<bool>(results, queryCount));
+    double batchNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+    cout << "Klucze: " << keyCount << ", zapytania: " << queryCount << "\n";
+    cout << "search w petli: " << singleNs / queryCount << " ns/zapytanie (znaleziono "
+         << foundSingle << ")\n";
+    cout << "searchBatch:    " << batchNs / queryCount << " ns/zapytanie (znaleziono "
+         << foundBatch << ")\n";
+
+    delete[] results;
+    return 0;
+}
@@ -0,0 +1,437 @@
+// Unified benchmark suite: HashTable / FlatHashTable insert and search, and every
+// single-pattern matcher over generated corpora (text size x alphabet x pattern length
+// x match density). Results go out as JSON so runs can be diffed to catch regressions.
+// Usage: ./benchmark_suite [--quick] [--output results.json]
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Algorytm KPM/compiled_kmp.h"
+#include "../hash_table.h"
+#include "../open_addressing_hash_table.h"
+#include "../wyszukaj_wzorzec/auto_search.h"
+#include "../wyszukaj_wzorzec/automat_wyszukiwanie_wzorca/compact_dfa.h"
+#include "../wyszukaj_wzorzec/rabin_karp.h"
+#include "../wyszukaj_wzorzec/simd_search.h"
+#include "../wyszukaj_wzorzec/skip_search.h"
+using namespace std;
+
+// Allocation counting: the tables allocate with malloc/calloc (arena chunks, bucket
+// arrays) as well as new, and glibc's operator new calls malloc too - so the malloc
+// family is wrapped and forwarded to glibc's own implementation. Over-aligned types
+// (the filter's alignas(64) blocks) go through operator new(size_t, align_val_t),
+// which calls aligned_alloc, so the aligned entry points are wrapped as well
+static atomic<size_t> allocationCount{0};
+static atomic<size_t> allocatedBytes{0};
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+    return __libc_malloc(size);
+}
+void* calloc(size_t count, size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(count * size, memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+void* realloc(void* p, size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+void* memalign(size_t alignment, size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+void* aligned_alloc(size_t alignment, size_t size) {
+    return memalign(alignment, size);
+}
+int posix_memalign(void** result, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+        return EINVAL;
+    }
+    void* p = memalign(alignment, size);
+    if (!p) {
+        return ENOMEM;
+    }
+    *result = p;
+    return 0;
+}
+}
+#endif
+
+struct AllocationSnapshot {
+    size_t count = allocationCount.load(memory_order_relaxed);
+    size_t bytes = allocatedBytes.load(memory_order_relaxed);
+};
+
+struct Options {
+    bool quick = false;
+    string output; // Empty - standard output
+};
+
+// Percentiles of a sorted sample
+double percentile(const vector<double>& sorted, double p) {
+    return sorted[(size_t)(p * (sorted.size() - 1))];
+}
+
+// One JSON object per result, written as "key": value pairs
+class JsonRecord {
+private:
+    string body;
+
+    void key(const string& name) {
+        body += body.empty() ? "{" : ", ";
+        body += "\"" + name + "\": ";
+    }
+
+public:
+    JsonRecord& add(const string& name, const string& value) {
+        key(name);
+        body += "\"" + value + "\"";
+        return *this;
+    }
+    JsonRecord& add(const string& name, double value) {
+        key(name);
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.6g", value);
+        body += buffer;
+        return *this;
+    }
+    JsonRecord& add(const string& name, size_t value) {
+        key(name);
+        body += to_string(value);
+        return *this;
+    }
+    string str() const { return body + "}"; }
+};
+
+// ---------------------------------------------------------------- hash tables
+
+vector<string> generateKeys(size_t count, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> length(4, 12);
+    uniform_int_distribution<int> letter('a', 'z');
+    vector<string> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        string key(length(rng), ' ');
+        for (char& ch : key) {
+            ch = (char)letter(rng);
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+// Runs operation(key) for every key: once as a tight loop (ns/op, allocations), once
+// timing each call separately (latency percentiles - includes steady_clock overhead)
+template <typename Operation>
+JsonRecord measureOperations(const vector<string>& keys, Operation operation,
+                             const function<void()>& resetBetweenPasses) {
+    resetBetweenPasses();
+    AllocationSnapshot before;
+    auto start = chrono::steady_clock::now();
+    for (const string& key : keys) {
+        operation(key);
+    }
+    double totalNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    AllocationSnapshot after;
+
+    resetBetweenPasses();
+    vector<double> latencies;
+    latencies.reserve(keys.size());
+    for (const string& key : keys) {
+        auto opStart = chrono::steady_clock::now();
+        operation(key);
+        latencies.push_back(
+            chrono::duration<double, nano>(chrono::steady_clock::now() - opStart).count());
+    }
+    sort(latencies.begin(), latencies.end());
+
+    JsonRecord record;
+    record.add("keys", keys.size())
+        .add("ns_per_op", totalNs / keys.size())
+        .add("allocations_per_op", (double)(after.count - before.count) / keys.size())
+        .add("allocated_bytes_per_op", (double)(after.bytes - before.bytes) / keys.size())
+        .add("p50_ns", percentile(latencies, 0.5))
+        .add("p90_ns", percentile(latencies, 0.9))
+        .add("p99_ns", percentile(latencies, 0.99))
+        .add("p999_ns", percentile(latencies, 0.999))
+        .add("max_ns", latencies.back());
+    return record;
+}
+
+// HashTable with the membership filter (bloom_filter.h) switched on from the start
+struct FilteredHashTable : HashTable<WyHash> {
+    explicit FilteredHashTable(int size) : HashTable<WyHash>(size) { enableFilter(); }
+};
+
+template <typename Table>
+void benchmarkTable(const string& name, size_t keyCount, vector<string>& results) {
+    vector<string> keys = generateKeys(keyCount, 1);
+    vector<string> missing = generateKeys(keyCount, 2);
+    optional<Table> table;
+    auto fresh = [&] {
+        table.reset();
+        table.emplace(13); // Starts small and grows, like the demo in main.cpp
+    };
+    auto insert = [&](const string& key) { table->insert(key); };
+    size_t found = 0;
+    auto search = [&](const string& key) { found += table->search(key); };
+    auto keep = [] {};
+
+    auto emit = [&](const char* operation, JsonRecord record) {
+        results.push_back(record.add("table", name).add("operation", operation).str());
+    };
+    emit("insert", measureOperations(keys, insert, fresh));
+    emit("search_hit", measureOperations(keys, search, keep));
+    emit("search_miss", measureOperations(missing, search, keep));
+    if (found == 0) {
+        cerr << "blad: " << name << " nie znalazl zadnego klucza\n";
+    }
+}
+
+// ---------------------------------------------------------------- matchers
+
+struct Corpus {
+    string text;
+    string pattern;
+    int alphabet;
+    const char* density;
+};
+
+// Random text over `alphabet` bytes ('a'.. for letters, all 256 byte values for 256),
+// with the pattern planted once per `stride` bytes (0 - never planted)
+Corpus generateCorpus(size_t size, int alphabet, size_t patternLength, size_t stride,
+                      const char* density) {
+    mt19937 rng((unsigned)(size + alphabet * 131 + patternLength * 7 + stride));
+    char first = alphabet == 256 ? 0 : 'a';
+    uniform_int_distribution<int> letter(0, alphabet - 1);
+    auto randomByte = [&] { return (char)(first + letter(rng)); };
+    Corpus corpus{string(size, ' '), string(patternLength, ' '), alphabet, density};
+    for (char& ch : corpus.text) {
+        ch = randomByte();
+    }
+    for (char& ch : corpus.pattern) {
+        ch = randomByte();
+    }
+    if (stride > 0) {
+        for (size_t block = 0; block + stride <= size; block += stride) {
+            size_t offset = block + rng() % (stride - patternLength + 1);
+            corpus.text.replace(offset, patternLength, corpus.pattern);
+        }
+    }
+    return corpus;
+}
+
+struct Engine {
+    const char* name;
+    // Prepares the pattern and returns the search; the search reports the match count
+    function<function<size_t(string_view)>(const string&)> prepare;
+};
+
+vector<Engine> matcherEngines() {
+    auto counting = [](auto matcher) {
+        return [matcher](string_view text) {
+            size_t found = 0;
+            matcher->search(text, [&](size_t) { found++; });
+            return found;
+        };
+    };
+    return {
+        {"naive", [](const string& pattern) {
+             return function<size_t(string_view)>([pattern](string_view text) {
+                 size_t found = 0;
+                 simdSearchWith(SimdLevel::Scalar, text, pattern, [&](size_t) { found++; });
+                 return found;
+             });
+         }},
+        {"naive_simd", [](const string& pattern) {
+             return function<size_t(string_view)>([pattern](string_view text) {
+                 size_t found = 0;
+                 simdSearch(text, pattern, [&](size_t) { found++; });
+                 return found;
+             });
+         }},
+        {"rabin_karp", [](const string& pattern) {
+             uint64_t base = Mersenne61::randomBase();
+             return function<size_t(string_view)>([pattern, base](string_view text) {
+                 size_t found = 0;
+                 rabinKarp61(text, pattern, [&](size_t) { found++; }, base);
+                 return found;
+             });
+         }},
+        {"dfa", [=](const string& pattern) {
+             return function<size_t(string_view)>(
+                 counting(make_shared<CompactDFA>(pattern)));
+         }},
+        {"kmp", [=](const string& pattern) {
+             return function<size_t(string_view)>(counting(
+                 make_shared<CompiledKMP>(pattern, CompiledKMP::Engine::FailureFunction)));
+         }},
+        {"kmp_dfa", [=](const string& pattern) {
+             return function<size_t(string_view)>(
+                 counting(make_shared<CompiledKMP>(pattern, CompiledKMP::Engine::DFA)));
+         }},
+        {"horspool", [=](const string& pattern) {
+             return function<size_t(string_view)>(
+                 counting(make_shared<HorspoolMatcher>(pattern)));
+         }},
+        {"two_way", [=](const string& pattern) {
+             return function<size_t(string_view)>(counting(make_shared<TwoWayMatcher>(pattern)));
+         }},
+        {"auto", [=](const string& pattern) {
+             return function<size_t(string_view)>(counting(make_shared<AutoMatcher>(pattern)));
+         }},
+    };
+}
+
+// Repeats the search until minBytes of text were scanned (at least minRuns times)
+JsonRecord measureSearch(const Corpus& corpus, const function<size_t(string_view)>& search,
+                         size_t minBytes, size_t minRuns) {
+    size_t runs = max(minRuns, minBytes / corpus.text.size());
+    vector<double> latencies;
+    latencies.reserve(runs);
+    size_t matches = 0;
+    AllocationSnapshot before;
+    for (size_t run = 0; run < runs; run++) {
+        auto start = chrono::steady_clock::now();
+        matches = search(corpus.text);
+        latencies.push_back(
+            chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+    }
+    AllocationSnapshot after;
+    sort(latencies.begin(), latencies.end());
+    double median = percentile(latencies, 0.5);
+
+    JsonRecord record;
+    record.add("text_bytes", corpus.text.size())
+        .add("alphabet", (size_t)corpus.alphabet)
+        .add("pattern_length", corpus.pattern.size())
+        .add("density", corpus.density)
+        .add("matches", matches)
+        .add("runs", runs)
+        .add("gb_per_s", corpus.text.size() / median)
+        .add("ns_per_op", median)
+        .add("ns_per_byte", median / corpus.text.size())
+        .add("allocations_per_op", (double)(after.count - before.count) / runs)
+        .add("p50_ns", median)
+        .add("p90_ns", percentile(latencies, 0.9))
+        .add("p99_ns", percentile(latencies, 0.99))
+        .add("max_ns", latencies.back());
+    return record;
+}
+
+// ---------------------------------------------------------------- main
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) {
+            options.quick = true;
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            options.output = argv[++i];
+        } else {
+            cerr << "Uzycie: " << argv[0] << " [--quick] [--output plik.json]\n";
+            return 1;
+        }
+    }
+
+    vector<size_t> keyCounts = options.quick ? vector<size_t>{10000, 100000}
+                                             : vector<size_t>{10000, 1000000};
+    vector<size_t> textSizes = options.quick ? vector<size_t>{64 << 10, 1 << 20}
+                                             : vector<size_t>{64 << 10, 8 << 20};
+    size_t minBytes = options.quick ? 4 << 20 : 32 << 20;
+    const int alphabets[] = {2, 4, 26, 256};
+    const size_t patternLengths[] = {4, 16, 64};
+    struct Density {
+        const char* name;
+        size_t stride;
+    };
+    const Density densities[] = {{"none", 0}, {"sparse", 64 << 10}, {"dense", 256}};
+
+    vector<string> hashResults;
+    for (size_t keyCount : keyCounts) {
+        cerr << "HashTable, " << keyCount << " kluczy...\n";
+        benchmarkTable<HashTable<WyHash>>("HashTable<WyHash>", keyCount, hashResults);
+        benchmarkTable<FilteredHashTable>("HashTable<WyHash>+filter", keyCount, hashResults);
+        benchmarkTable<FlatHashTable<WyHash>>("FlatHashTable<WyHash>", keyCount, hashResults);
+    }
+
+    vector<string> matcherResults;
+    vector<Engine> engines = matcherEngines();
+    for (size_t size : textSizes) {
+        for (int alphabet : alphabets) {
+            for (size_t patternLength : patternLengths) {
+                for (const Density& density : densities) {
+                    if (density.stride > size) {
+                        continue;
+                    }
+                    Corpus corpus = generateCorpus(size, alphabet, patternLength, density.stride,
+                                                   density.name);
+                    cerr << "Tekst " << size << " B, alfabet " << alphabet << ", wzorzec "
+                         << patternLength << ", gestosc " << density.name << "...\n";
+                    size_t expected = 0;
+                    for (const Engine& engine : engines) {
+                        auto search = engine.prepare(corpus.pattern);
+                        JsonRecord record = measureSearch(corpus, search, minBytes, 5);
+                        size_t matches = search(corpus.text);
+                        if (&engine == &engines.front()) {
+                            expected = matches;
+                        } else if (matches != expected) {
+                            cerr << "blad: " << engine.name << " znalazl " << matches
+                                 << " dopasowan, oczekiwano " << expected << "\n";
+                            return 1;
+                        }
+                        matcherResults.push_back(record.add("engine", engine.name).str());
+                    }
+                }
+            }
+        }
+    }
+
+    ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            cerr << "Nie mozna zapisac " << options.output << "\n";
+            return 1;
+        }
+    }
+    ostream& out = options.output.empty() ? cout : file;
+    auto writeArray = [&](const char* name, const vector<string>& records, bool last) {
+        out << "  \"" << name << "\": [\n";
+        for (size_t i = 0; i < records.size(); i++) {
+            out << "    " << records[i] << (i + 1 < records.size() ? ",\n" : "\n");
+        }
+        out << "  ]" << (last ? "\n" : ",\n");
+    };
+    const char* simdNames[] = {"scalar", "sse2", "avx2"};
+    out << "{\n";
+    out << "  \"simd_level\": \"" << simdNames[(int)detectSimdLevel()] << "\",\n";
+    out << "  \"quick\": " << (options.quick ? "true" : "false") << ",\n";
+    writeArray("hash_table", hashResults, false);
+    writeArray("matchers", matcherResults, true);
+    out << "}\n";
+    return 0;
+}
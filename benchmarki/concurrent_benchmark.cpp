@@ -0,0 +1,106 @@
+// Multithreaded throughput: ConcurrentHashTable vs HashTable behind one global mutex.
+// Usage: ./concurrent_benchmark [max_threads] [number_of_keys] [operations_per_thread]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../concurrent_hash_table.h"
+#include "../hash_table.h"
+#include "thread_counts.h"
+using namespace std;
+
+// Today's setup: the single-threaded table serialized behind an external mutex
+class LockedHashTable {
+private:
+    HashTable<WyHash> table;
+    mutex lock;
+
+public:
+    LockedHashTable(int tableSize) : table(tableSize) {}
+
+    void insert(const string& key) {
+        lock_guard<mutex> guard(lock);
+        table.insert(key);
+    }
+    bool search(const string& key) {
+        lock_guard<mutex> guard(lock);
+        return table.search(key);
+    }
+    bool erase(const string& key) {
+        lock_guard<mutex> guard(lock);
+        return table.erase(key);
+    }
+};
+
+vector<string> generateKeys(int count) {
+    vector<string> keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; i++) {
+        keys.push_back("klucz_" + to_string(i));
+    }
+    return keys;
+}
+
+// Millions of operations per second for the given thread count and read percentage.
+// Writes alternate between insert and erase so the table size stays roughly constant.
+template <typename Table>
+double throughput(Table& table, const vector<string>& keys, int threads, int readPercent,
+                  int operations) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            mt19937 rng(t + 1);
+            uniform_int_distribution<int> pickKey(0, (int)keys.size() - 1);
+            uniform_int_distribution<int> pickOp(0, 99);
+            int found = 0;
+            for (int i = 0; i < operations; i++) {
+                const string& key = keys[pickKey(rng)];
+                if (pickOp(rng) < readPercent) {
+                    found += table.search(key);
+                } else if (i & 1) {
+                    table.insert(key);
+                } else {
+                    table.erase(key);
+                }
+            }
+            if (found < 0) cout << found; // Keep the searches from being optimized out
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return (double)threads * operations / seconds / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)thread::hardware_concurrency();
+    int keyCount = argc > 2 ? atoi(argv[2]) : 100000;
+    int operations = argc > 3 ? atoi(argv[3]) : 200000;
+    if (maxThreads < 1) maxThreads = 1;
+
+    vector<string> keys = generateKeys(keyCount);
+    const int readPercents[] = {50, 90, 99};
+
+    cout << "watki\todczyty%\tConcurrentHashTable Mops/s\tHashTable+mutex Mops/s\n";
+    for (int threads : threadCounts(maxThreads)) {
+        for (int readPercent : readPercents) {
+            ConcurrentHashTable<WyHash> concurrent(keyCount);
+            LockedHashTable locked(keyCount);
+            for (int i = 0; i < keyCount; i += 2) { // Half of the keys present at start
+                concurrent.insert(keys[i]);
+                locked.insert(keys[i]);
+            }
+            double concurrentMops = throughput(concurrent, keys, threads, readPercent, operations);
+            double lockedMops = throughput(locked, keys, threads, readPercent, operations);
+            cout << threads << "\t" << readPercent << "\t" << concurrentMops << "\t" << lockedMops
+                 << "\n";
+        }
+    }
+    return 0;
+}
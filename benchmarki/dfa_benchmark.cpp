@@ -0,0 +1,76 @@
+// Benchmark: DFA with buildDFA's layout (m+1 separate int[256] rows) vs CompactDFA
+// (one allocation, uint8_t/uint16_t states, byte-class alphabet compression).
+// Usage: ./dfa_benchmark [text_megabytes] [pattern_length]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../wyszukaj_wzorzec/automat_wyszukiwanie_wzorca/compact_dfa.h"
+using namespace std;
+
+// Same construction and layout as buildDFA in automat.cpp
+static int** buildRowDFA(const string& pattern) {
+    int m = pattern.size();
+    int** dfa = new int*[m + 1];
+    for (int i = 0; i <= m; i++) {
+        dfa[i] = new int[256]();
+    }
+    dfa[0][(unsigned char)pattern[0]] = 1;
+    int fallback = 0;
+    for (int state = 1; state <= m; state++) {
+        for (int c = 0; c < 256; c++) {
+            dfa[state][c] = dfa[fallback][c];
+        }
+        if (state < m) {
+            dfa[state][(unsigned char)pattern[state]] = state + 1;
+            fallback = dfa[fallback][(unsigned char)pattern[state]];
+        }
+    }
+    return dfa;
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 64;
+    int patternLength = argc > 2 ? atoi(argv[2]) : 64;
+
+    // Small alphabet, so the automaton really walks through deep states
+    mt19937 rng(11);
+    uniform_int_distribution<int> letter('a', 'd');
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = (char)letter(rng);
+    }
+    string pattern = text.substr(text.size() / 2, patternLength);
+
+    auto start = chrono::steady_clock::now();
+    int** rows = buildRowDFA(pattern);
+    size_t rowMatches = 0;
+    int state = 0;
+    for (char ch : text) {
+        state = rows[state][(unsigned char)ch];
+        if (state == patternLength) {
+            rowMatches++;
+        }
+    }
+    double rowSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    for (int i = 0; i <= patternLength; i++) {
+        delete[] rows[i];
+    }
+    delete[] rows;
+
+    start = chrono::steady_clock::now();
+    CompactDFA compact(pattern);
+    size_t compactMatches = 0;
+    compact.search(text, [&](size_t) { compactMatches++; });
+    double compactSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "Tekst: " << megabytes << " MB, wzorzec: " << patternLength << " znakow\n";
+    cout << "buildDFA (int[256] na stan): " << (patternLength + 1) * 256 * sizeof(int) / 1024
+         << " KB, " << text.size() / rowSeconds / 1e6 << " MB/s, dopasowania: " << rowMatches
+         << "\n";
+    cout << "CompactDFA (" << compact.stateBytes() << " B na stan, " << compact.alphabetSize()
+         << " klas): " << compact.tableBytes() << " B, " << text.size() / compactSeconds / 1e6
+         << " MB/s, dopasowania: " << compactMatches << "\n";
+    return 0;
+}
@@ -0,0 +1,46 @@
+// Bucket distribution report for every hasher from hashers.h on a given key set.
+// Usage: ./hash_distribution [keys_file] [table_size]
+// Keys are read one per line (from stdin when no file is given).
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../hash_table.h"
+using namespace std;
+
+template <typename Hasher>
+void report(const string& name, const vector<string>& keys, int tableSize) {
+    HashTable<Hasher> table(tableSize);
+    for (const string& key : keys) {
+        table.insert(key);
+    }
+    cout << "=== " << name << " ===\n";
+    table.printBucketReport();
+    cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> keys;
+    string line;
+    if (argc > 1) {
+        ifstream file(argv[1]);
+        if (!file) {
+            cerr << "Nie mozna otworzyc pliku: " << argv[1] << endl;
+            return 1;
+        }
+        while (getline(file, line)) keys.push_back(line);
+    } else {
+        while (getline(cin, line)) keys.push_back(line);
+    }
+    if (keys.empty()) {
+        cerr << "Brak kluczy" << endl;
+        return 1;
+    }
+    int tableSize = argc > 2 ? atoi(argv[2]) : (int)keys.size();
+
+    report<AdditiveHash>("AdditiveHash", keys, tableSize);
+    report<WyHash>("WyHash", keys, tableSize);
+    report<SeededWyHash>("SeededWyHash", keys, tableSize);
+    return 0;
+}
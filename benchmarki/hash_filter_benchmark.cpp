@@ -0,0 +1,99 @@
+// Benchmark: HashTable lookups with and without the membership filter (bloom_filter.h)
+// for growing shares of absent keys, plus insert/erase churn that keeps the filter in sync.
+// Usage: ./hash_filter_benchmark [number_of_keys] [false_positive_rate]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../hash_table.h"
+using namespace std;
+
+// Random lowercase names of 4..12 letters
+vector<string> generateKeys(int count, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> length(4, 12);
+    uniform_int_distribution<int> letter('a', 'z');
+    vector<string> keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; i++) {
+        string key(length(rng), ' ');
+        for (char& ch : key) {
+            ch = (char)letter(rng);
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+template <typename Function>
+double nsPerOp(size_t operations, Function function) {
+    auto start = chrono::steady_clock::now();
+    function();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(stop - start).count() / operations;
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    double falsePositive = argc > 2 ? atof(argv[2]) : 0.01;
+    vector<string> keys = generateKeys(count, 1);
+    vector<string> missing = generateKeys(count, 2);
+
+    HashTable<WyHash> plain(count);
+    HashTable<WyHash> filtered(count);
+    filtered.enableFilter(falsePositive, count);
+    for (const string& key : keys) {
+        plain.insert(key);
+        filtered.insert(key);
+    }
+    cout << "Liczba kluczy: " << count << ", filtr: " << filtered.stats().filterBytes
+         << " B (" << (double)filtered.stats().filterBytes / count << " B/klucz)\n";
+
+    mt19937 rng(3);
+    for (int missPercent : {0, 50, 90, 99, 100}) {
+        // Copies, so the query strings are read sequentially like in hash_table_benchmark
+        vector<string> queryKeys;
+        queryKeys.reserve(count);
+        for (int i = 0; i < count; i++) {
+            bool miss = (int)(rng() % 100) < missPercent;
+            queryKeys.push_back(miss ? missing[rng() % count] : keys[rng() % count]);
+        }
+        vector<string_view> queries(queryKeys.begin(), queryKeys.end());
+        size_t hits[2] = {0, 0};
+        double searchNs[2], batchNs[2];
+        HashTable<WyHash>* tables[2] = {&plain, &filtered};
+        for (int t = 0; t < 2; t++) {
+            searchNs[t] = nsPerOp(queries.size(), [&] {
+                for (string_view query : queries) hits[t] += tables[t]->search(query);
+            });
+            bool* results = new bool[queries.size()];
+            batchNs[t] = nsPerOp(queries.size(), [&] {
+                tables[t]->searchBatch(queries, span<bool>(results, queries.size()));
+            });
+            delete[] results;
+        }
+        cout << missPercent << "% nieobecnych: search " << searchNs[0] << " -> " << searchNs[1]
+             << " ns/op, searchBatch " << batchNs[0] << " -> " << batchNs[1] << " ns/op"
+             << (hits[0] == hits[1] ? "" : " (NIEZGODNOSC)") << "\n";
+    }
+
+    // Churn: erase and re-insert, the filter follows both
+    double churnNs[2];
+    HashTable<WyHash>* tables[2] = {&plain, &filtered};
+    for (int t = 0; t < 2; t++) {
+        churnNs[t] = nsPerOp(2 * keys.size(), [&] {
+            for (const string& key : keys) {
+                tables[t]->erase(key);
+                tables[t]->insert(key);
+            }
+        });
+    }
+    cout << "erase + insert: " << churnNs[0] << " -> " << churnNs[1] << " ns/op\n";
+    size_t stillFound = 0;
+    for (const string& key : keys) stillFound += filtered.search(key);
+    cout << "Po wymianie znaleziono " << stillFound << " z " << count << " kluczy\n";
+    return stillFound == (size_t)count ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+// Benchmark: chained HashTable vs open addressing FlatHashTable.
+// Usage: ./hash_table_benchmark [number_of_keys]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../hash_table.h"
+#include "../open_addressing_hash_table.h"
+using namespace std;
+
+// Random lowercase names of 4..12 letters
+vector<string> generateKeys(int count, unsigned seed) {
+    mt19937 rng(seed);
+    uniform_int_distribution<int> length(4, 12);
+    uniform_int_distribution<int> letter('a', 'z');
+    vector<string> keys;
+    keys.reserve(count);
+    for (int i = 0; i < count; i++) {
+        string key(length(rng), ' ');
+        for (char& ch : key) {
+            ch = (char)letter(rng);
+        }
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+template <typename Function>
+double nsPerOp(int operations, Function function) {
+    auto start = chrono::steady_clock::now();
+    function();
+    auto stop = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(stop - start).count() / operations;
+}
+
+template <typename Table>
+void runBenchmark(const string& name, Table& table, const vector<string>& keys,
+                  const vector<string>& missing) {
+    int found = 0;
+    double insertNs = nsPerOp(keys.size(), [&] {
+        for (const string& key : keys) table.insert(key);
+    });
+    double hitNs = nsPerOp(keys.size(), [&] {
+        for (const string& key : keys) found += table.search(key);
+    });
+    double missNs = nsPerOp(missing.size(), [&] {
+        for (const string& key : missing) found += table.search(key);
+    });
+    cout << name << ": insert " << insertNs << " ns/op, search (hit) " << hitNs
+         << " ns/op, search (miss) " << missNs << " ns/op (found " << found << ")\n";
+}
+
+// Per-insert latency of a table that starts with 13 buckets and has to grow
+template <typename Table>
+void insertLatency(const string& name, Table& table, const vector<string>& keys) {
+    vector<double> latencies;
+    latencies.reserve(keys.size());
+    for (const string& key : keys) {
+        auto start = chrono::steady_clock::now();
+        table.insert(key);
+        auto stop = chrono::steady_clock::now();
+        latencies.push_back(chrono::duration<double, nano>(stop - start).count());
+    }
+    sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) { return latencies[(size_t)(p * (latencies.size() - 1))]; };
+    cout << name << ": insert p50 " << percentile(0.5) << " ns, p99 " << percentile(0.99)
+         << " ns, p99.9 " << percentile(0.999) << " ns, max " << latencies.back() << " ns\n";
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 50000;
+    vector<string> keys = generateKeys(count, 1);
+    vector<string> missing = generateKeys(count, 2);
+
+    cout << "Liczba kluczy: " << count << "\n";
+
+    HashTable<AdditiveHash> additive(count);
+    runBenchmark("HashTable<AdditiveHash> (chained)", additive, keys, missing);
+
+    HashTable<WyHash> chained(count);
+    runBenchmark("HashTable<WyHash> (chained)", chained, keys, missing);
+
+    FlatHashTable<WyHash> flat;
+    runBenchmark("FlatHashTable<WyHash> (open addressing)", flat, keys, missing);
+
+    // Bulk load into a reserved table, then teardown
+    HashTable<WyHash>* bulk = new HashTable<WyHash>(13);
+    double bulkNs = nsPerOp(keys.size(), [&] {
+        bulk->reserve(keys.size());
+        for (const string& key : keys) bulk->insert(key);
+    });
+    double teardownNs = nsPerOp(1, [&] { delete bulk; });
+    cout << "HashTable<WyHash> (reserve + wstawianie): " << bulkNs << " ns/op, destruktor "
+         << teardownNs / 1000 << " us\n";
+
+    HashTable<WyHash> growing(13);
+    insertLatency("HashTable<WyHash> (13 kubelkow, przyrostowe powiekszanie)", growing, keys);
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+// Benchmark: KMP inner loops - classic LPS loop (as in KMPSearchSteps, without printing)
+// vs CompiledKMP with the strong failure function vs CompiledKMP compiled to a DFA.
+// Usage: ./kmp_benchmark [text_megabytes] [alphabet_size]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../Algorytm KPM/compiled_kmp.h"
+using namespace std;
+
+// KMPSearchSteps without the printMatchState calls
+size_t classicKMP(const string& text, const string& pattern, const vector<int>& lps) {
+    size_t found = 0;
+    int n = (int)text.size(), m = (int)pattern.size();
+    int i = 0, j = 0;
+    while (i < n) {
+        if (text[i] == pattern[j]) {
+            i++;
+            j++;
+            if (j == m) {
+                found++;
+                j = lps[j - 1];
+            }
+        } else if (j != 0) {
+            j = lps[j - 1];
+        } else {
+            i++;
+        }
+    }
+    return found;
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 64;
+    int alphabet = argc > 2 ? atoi(argv[2]) : 2;
+
+    // Small alphabet and a periodic pattern: many partial matches, a lot of falling back
+    mt19937 rng(19);
+    uniform_int_distribution<int> letter(0, alphabet - 1);
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = (char)('a' + letter(rng));
+    }
+    const string patterns[] = {"aaaaaaab", "abababababababac", text.substr(1000, 200)};
+
+    for (const string& pattern : patterns) {
+        CompiledKMP failure(pattern, CompiledKMP::Engine::FailureFunction);
+        CompiledKMP automaton(pattern, CompiledKMP::Engine::DFA);
+        auto run = [&](const char* name, auto search) {
+            auto start = chrono::steady_clock::now();
+            size_t found = search();
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            cout << "  " << name << ": " << text.size() / seconds / 1e6 << " MB/s (" << found
+                 << " dopasowan)\n";
+        };
+        cout << "Wzorzec o dlugosci " << pattern.size() << ":\n";
+        run("klasyczna petla LPS", [&] { return classicKMP(text, pattern, failure.lpsTable()); });
+        run("CompiledKMP, silna funkcja porazki", [&] { return failure.count(text); });
+        run("CompiledKMP, automat DFA", [&] { return automaton.count(text); });
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+// Cost of reporting matches on match-dense text: printing every hit with endl vs
+// collecting positions into a preallocated vector vs counting only (match_sinks.h).
+// Usage: ./match_output_benchmark [text_megabytes]
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../wyszukaj_wzorzec/automat_wyszukiwanie_wzorca/compact_dfa.h"
+#include "../wyszukaj_wzorzec/match_sinks.h"
+#include "../wyszukaj_wzorzec/simd_search.h"
+using namespace std;
+
+template <typename Search>
+double seconds(Search search) {
+    auto start = chrono::steady_clock::now();
+    search();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 16;
+
+    // Two letters and a two-letter pattern: roughly every fourth position is a match
+    mt19937 rng(17);
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = rng() & 1 ? 'a' : 'b';
+    }
+    string pattern = "ab";
+    CompactDFA dfa(pattern);
+    ofstream sink("/dev/null"); // A real stream, so every endl really flushes
+
+    size_t printed = 0;
+    double printSeconds = seconds([&] {
+        dfa.search(text, [&](size_t i) {
+            sink << "Znaleziono wystapienie wzorca na pozycji: " << i << endl;
+            printed++;
+        });
+    });
+    vector<size_t> positions;
+    positions.reserve(text.size() / 2);
+    double collectSeconds = seconds([&] { dfa.search(text, collectInto(positions)); });
+    size_t counted = 0;
+    double countSeconds = seconds([&] { counted = dfa.count(text); });
+    size_t simdCounted = 0;
+    double simdSeconds = seconds([&] { simdSearch(text, pattern, countInto(simdCounted)); });
+
+    auto report = [&](const char* name, double s, size_t matches) {
+        cout << name << ": " << text.size() / s / 1e6 << " MB/s, dopasowania: " << matches << "\n";
+    };
+    cout << "Tekst: " << megabytes << " MB, wzorzec: \"" << pattern << "\"\n";
+    report("CompactDFA + << endl", printSeconds, printed);
+    report("CompactDFA + collectInto", collectSeconds, positions.size());
+    report("CompactDFA::count", countSeconds, counted);
+    report("simdSearch + countInto", simdSeconds, simdCounted);
+    return 0;
+}
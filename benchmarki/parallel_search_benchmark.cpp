@@ -0,0 +1,56 @@
+// Scaling of parallelSearch from 1 thread to all cores, for every algorithm.
+// Usage: ./parallel_search_benchmark [max_threads] [text_megabytes] [pattern_length]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../wyszukaj_wzorzec/parallel_search.h"
+#include "thread_counts.h"
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int maxThreads = argc > 1 ? atoi(argv[1]) : (int)thread::hardware_concurrency();
+    size_t megabytes = argc > 2 ? atoi(argv[2]) : 256;
+    int patternLength = argc > 3 ? atoi(argv[3]) : 16;
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    mt19937 rng(13);
+    uniform_int_distribution<int> letter('a', 'h');
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = (char)letter(rng);
+    }
+    string pattern = text.substr(text.size() / 3, patternLength);
+
+    struct Named {
+        const char* name;
+        SearchAlgorithm algorithm;
+    };
+    const Named algorithms[] = {{"DFA", SearchAlgorithm::DFA},
+                                {"KMP", SearchAlgorithm::KMP},
+                                {"Rabin-Karp", SearchAlgorithm::RabinKarp},
+                                {"naiwny SIMD", SearchAlgorithm::Naive}};
+
+    cout << "Tekst: " << megabytes << " MB, wzorzec: " << patternLength << " znakow\n";
+    cout << "algorytm\twatki\tMB/s\tprzyspieszenie\tdopasowania\n";
+    for (const Named& named : algorithms) {
+        double single = 0;
+        for (int threads : threadCounts(maxThreads)) {
+            auto start = chrono::steady_clock::now();
+            vector<uint64_t> positions = parallelSearch(text, pattern, named.algorithm, threads);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            double throughput = text.size() / seconds / 1e6;
+            if (threads == 1) {
+                single = throughput;
+            }
+            cout << named.name << "\t" << threads << "\t" << throughput << "\t"
+                 << throughput / single << "\t" << positions.size() << "\n";
+        }
+    }
+    return 0;
+}
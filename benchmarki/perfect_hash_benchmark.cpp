@@ -0,0 +1,63 @@
+// Benchmark: static PerfectHashTable vs dynamic HashTable - build time and query time.
+// Usage: ./perfect_hash_benchmark [number_of_keys]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../hash_table.h"
+#include "../perfect_hash_table.h"
+using namespace std;
+
+template <typename Function>
+double elapsedMs(Function function) {
+    auto start = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename Table>
+void queryBenchmark(const string& name, Table& table, const vector<string>& queries) {
+    size_t found = 0;
+    double ms = elapsedMs([&] {
+        for (const string& query : queries) found += table.search(query);
+    });
+    cout << name << ": " << ms * 1e6 / queries.size() << " ns/zapytanie (znaleziono " << found
+         << ")\n";
+}
+
+int main(int argc, char* argv[]) {
+    int keyCount = argc > 1 ? atoi(argv[1]) : 1000000;
+
+    vector<string> keys;
+    keys.reserve(keyCount);
+    for (int i = 0; i < keyCount; i++) {
+        keys.push_back("imie_" + to_string(i));
+    }
+    mt19937 rng(3);
+    uniform_int_distribution<int> pick(0, 2 * keyCount - 1); // Half hits, half misses
+    vector<string> queries;
+    for (int i = 0; i < keyCount; i++) {
+        queries.push_back("imie_" + to_string(pick(rng)));
+    }
+
+    cout << "Klucze: " << keyCount << "\n";
+
+    HashTable<WyHash> dynamic(13);
+    double dynamicMs = elapsedMs([&] {
+        for (const string& key : keys) dynamic.insert(key);
+    });
+    cout << "HashTable budowa: " << dynamicMs << " ms\n";
+
+    PerfectHashTable* perfect = nullptr;
+    double perfectMs = elapsedMs([&] { perfect = new PerfectHashTable(keys); });
+    cout << "PerfectHashTable budowa: " << perfectMs << " ms, funkcja haszujaca: "
+         << perfect->functionBitsPerKey() << " bitow/klucz\n";
+
+    queryBenchmark("HashTable", dynamic, queries);
+    queryBenchmark("PerfectHashTable", *perfect, queries);
+
+    delete perfect;
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Benchmark: MultiPatternRabinKarp (one pass) vs one rabinKarp61 pass per pattern.
+// Usage: ./rabin_karp_benchmark [text_megabytes] [number_of_patterns] [pattern_length]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../wyszukaj_wzorzec/rabin_karp.h"
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 16;
+    int patternCount = argc > 2 ? atoi(argv[2]) : 1000;
+    int patternLength = argc > 3 ? atoi(argv[3]) : 8;
+
+    mt19937 rng(5);
+    uniform_int_distribution<int> letter('a', 'z');
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = (char)letter(rng);
+    }
+    // Half of the patterns are taken from the text, so there are matches to report
+    vector<string> patterns;
+    uniform_int_distribution<size_t> offset(0, text.size() - patternLength);
+    for (int i = 0; i < patternCount; i++) {
+        if (i % 2 == 0) {
+            patterns.push_back(text.substr(offset(rng), patternLength));
+        } else {
+            string pattern(patternLength, ' ');
+            for (char& ch : pattern) ch = (char)letter(rng);
+            patterns.push_back(pattern);
+        }
+    }
+
+    size_t multiMatches = 0;
+    auto start = chrono::steady_clock::now();
+    MultiPatternRabinKarp matcher(patterns);
+    matcher.search(text, [&](size_t, size_t) { multiMatches++; });
+    double multiSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    // One pass per pattern is slow, so measure a sample of passes and extrapolate
+    int sample = patternCount < 20 ? patternCount : 20;
+    size_t sampleMatches = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < sample; i++) {
+        rabinKarp61(text, patterns[i], [&](size_t) { sampleMatches++; });
+    }
+    double loopSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() *
+                         patternCount / sample;
+
+    cout << "Tekst: " << megabytes << " MB, wzorce: " << patternCount << " x " << patternLength
+         << " znakow\n";
+    cout << "MultiPatternRabinKarp (1 przejscie): " << multiSeconds << " s, "
+         << text.size() / multiSeconds / 1e6 << " MB/s, dopasowania: " << multiMatches << "\n";
+    cout << "rabinKarp61 w petli (" << patternCount << " przejsc, oszacowane z " << sample
+         << "): " << loopSeconds << " s, dopasowania w probce: " << sampleMatches << "\n";
+    return 0;
+}
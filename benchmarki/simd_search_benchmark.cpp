@@ -0,0 +1,47 @@
+// Benchmark: naive search kernels from simd_search.h (scalar / SSE2 / AVX2),
+// case-sensitive and case-insensitive (in place, no lowercase copy of the text).
+// Usage: ./simd_search_benchmark [text_megabytes]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../wyszukaj_wzorzec/simd_search.h"
+using namespace std;
+
+// Random lowercase text - realistic: first/last byte of the pattern match ~1/26 positions
+string generateText(size_t size) {
+    mt19937 rng(11);
+    uniform_int_distribution<int> letter('a', 'z');
+    string text(size, ' ');
+    for (char& ch : text) {
+        ch = (char)letter(rng);
+    }
+    return text;
+}
+
+void runKernel(const string& name, SimdLevel level, const string& text, const string& pattern,
+               CaseMode mode = CaseMode::Sensitive) {
+    size_t matches = 0;
+    auto start = chrono::steady_clock::now();
+    simdSearchWith(level, text, pattern, [&](size_t) { matches++; }, mode);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << name << ": " << text.size() / seconds / 1e9 << " GB/s (" << matches
+         << " dopasowan)\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 256;
+    string text = generateText(megabytes << 20);
+    const string patterns[] = {"ab", "abc", "wzorzec", "bardzo_dlugi_wzorzec_32_znakow__"};
+
+    SimdLevel best = detectSimdLevel();
+    for (const string& pattern : patterns) {
+        cout << "Wzorzec \"" << pattern << "\" (" << pattern.size() << " znakow):\n";
+        runKernel("skalarny", SimdLevel::Scalar, text, pattern);
+        if (best >= SimdLevel::SSE2) runKernel("SSE2", SimdLevel::SSE2, text, pattern);
+        if (best >= SimdLevel::AVX2) runKernel("AVX2", SimdLevel::AVX2, text, pattern);
+        runKernel("najlepszy, bez wielkosci liter", best, text, pattern, CaseMode::Insensitive);
+    }
+    return 0;
+}
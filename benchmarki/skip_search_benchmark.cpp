@@ -0,0 +1,62 @@
+// Benchmark: skip-based matchers (Horspool, Two-Way) vs naive SIMD and CompiledKMP,
+// plus the engine picked by AutoMatcher. Three texts: random letters, random binary
+// and the worst case for naive/Horspool ("aaaa..." searched for "aa..ab..aa").
+// Usage: ./skip_search_benchmark [text_megabytes]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "../wyszukaj_wzorzec/auto_search.h"
+using namespace std;
+
+string randomText(size_t size, char first, int alphabet) {
+    mt19937 rng(20);
+    uniform_int_distribution<int> letter(0, alphabet - 1);
+    string text(size, ' ');
+    for (char& ch : text) {
+        ch = (char)(first + letter(rng));
+    }
+    return text;
+}
+
+template <typename Search>
+void run(const char* name, const string& text, Search search) {
+    size_t matches = 0;
+    auto start = chrono::steady_clock::now();
+    search([&](size_t) { matches++; });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << name << ": " << text.size() / seconds / 1e6 << " MB/s (" << matches
+         << " dopasowan)\n";
+}
+
+void compare(const char* label, const string& text, const string& pattern) {
+    HorspoolMatcher horspool(pattern);
+    TwoWayMatcher twoWay(pattern);
+    CompiledKMP kmp(pattern);
+    AutoMatcher automatic(pattern);
+    cout << label << ", wzorzec " << pattern.size() << " znakow (wybor: "
+         << engineName(automatic.engineUsed()) << "):\n";
+    run("Horspool", text, [&](auto onMatch) { horspool.search(text, onMatch); });
+    run("Two-Way", text, [&](auto onMatch) { twoWay.search(text, onMatch); });
+    run("naiwny SIMD", text, [&](auto onMatch) { simdSearch(text, pattern, onMatch); });
+    run("CompiledKMP", text, [&](auto onMatch) { kmp.search(text, onMatch); });
+    run("AutoMatcher", text, [&](auto onMatch) { automatic.search(text, onMatch); });
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 64;
+    size_t size = megabytes << 20;
+
+    string letters = randomText(size, 'a', 26);
+    string binary = randomText(size, '0', 2);
+    string same(size, 'a');
+    for (size_t m : {16, 64, 256}) {
+        compare("Litery", letters, letters.substr(12345, m));
+        compare("Binarny", binary, binary.substr(12345, m));
+        string worst(m, 'a');
+        worst[m / 2] = 'b';
+        compare("Najgorszy przypadek", same, worst);
+    }
+    return 0;
+}
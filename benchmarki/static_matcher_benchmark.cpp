@@ -0,0 +1,77 @@
+// Benchmark: fixed pattern known at compile time (StaticMatcher, tables built by the
+// compiler) vs the same automaton built at runtime (CompactDFA) and CompiledKMP.
+// Two workloads: one long text (throughput) and many short lines, where building
+// the tables on every call (like buildDFA / computeLPSArray do) dominates.
+// Usage: ./static_matcher_benchmark [text_megabytes] [line_count]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Algorytm KPM/compiled_kmp.h"
+#include "../wyszukaj_wzorzec/automat_wyszukiwanie_wzorca/compact_dfa.h"
+#include "../wyszukaj_wzorzec/static_matcher.h"
+using namespace std;
+
+constexpr FixedPattern PATTERN = "GET /index.html";
+
+template <typename Function>
+void run(const char* name, double bytes, Function function) {
+    auto start = chrono::steady_clock::now();
+    size_t found = function();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << name << ": " << bytes / seconds / 1e6 << " MB/s (" << found
+         << " dopasowan)\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 64;
+    size_t lineCount = argc > 2 ? atoi(argv[2]) : 1000000;
+    string pattern(PATTERN.view());
+
+    mt19937 rng(23);
+    uniform_int_distribution<int> letter(' ', '~');
+    auto randomText = [&](size_t size) {
+        string text(size, ' ');
+        for (char& ch : text) {
+            ch = (char)letter(rng);
+        }
+        if (size > pattern.size() && rng() % 4 == 0) {
+            text.replace(rng() % (size - pattern.size()), pattern.size(), pattern);
+        }
+        return text;
+    };
+
+    string text = randomText(megabytes << 20);
+    cout << "Jeden tekst " << megabytes << " MB:\n";
+    run("StaticMatcher", text.size(), [&] { return StaticMatcher<PATTERN>::count(text); });
+    CompactDFA dfa(pattern);
+    run("CompactDFA", text.size(), [&] { return dfa.count(text); });
+    CompiledKMP kmp(pattern, CompiledKMP::Engine::FailureFunction);
+    run("CompiledKMP (funkcja porazki)", text.size(), [&] { return kmp.count(text); });
+
+    vector<string> lines;
+    double lineBytes = 0;
+    for (size_t i = 0; i < lineCount; i++) {
+        lines.push_back(randomText(40 + rng() % 80));
+        lineBytes += lines.back().size();
+    }
+    cout << lineCount << " krotkich linii, tablice budowane przy kazdym wywolaniu:\n";
+    run("StaticMatcher (bez budowania)", lineBytes, [&] {
+        size_t found = 0;
+        for (const string& line : lines) found += StaticMatcher<PATTERN>::count(line);
+        return found;
+    });
+    run("CompactDFA budowany dla linii", lineBytes, [&] {
+        size_t found = 0;
+        for (const string& line : lines) found += CompactDFA(pattern).count(line);
+        return found;
+    });
+    run("CompiledKMP budowany dla linii", lineBytes, [&] {
+        size_t found = 0;
+        for (const string& line : lines) found += CompiledKMP(pattern).count(line);
+        return found;
+    });
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Benchmark: many queries over one static text. SuffixArrayIndex (built once, O(m log n)
+// per query) vs CompactDFA (same automaton as searchWithDFA) and CompiledKMP, which
+// scan the whole text for every pattern. Half of the patterns occur in the text, half
+// are random; every engine must report the same match counts.
+// Usage: ./suffix_array_benchmark [text_megabytes] [query_count]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Algorytm KPM/compiled_kmp.h"
+#include "../wyszukaj_wzorzec/automat_wyszukiwanie_wzorca/compact_dfa.h"
+#include "../wyszukaj_wzorzec/suffix_array.h"
+using namespace std;
+
+template <typename Function>
+double seconds(Function function) {
+    auto start = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t megabytes = argc > 1 ? atoi(argv[1]) : 8;
+    size_t queryCount = argc > 2 ? atoi(argv[2]) : 100;
+
+    mt19937 rng(24);
+    uniform_int_distribution<int> letter('a', 'z');
+    string text(megabytes << 20, ' ');
+    for (char& ch : text) {
+        ch = (char)letter(rng);
+    }
+    vector<string> queries;
+    for (size_t i = 0; i < queryCount; i++) {
+        size_t length = 4 + rng() % 13;
+        if (i % 2 == 0) {
+            queries.push_back(text.substr(rng() % (text.size() - length), length));
+        } else {
+            string pattern(length, ' ');
+            for (char& ch : pattern) ch = (char)letter(rng);
+            queries.push_back(pattern);
+        }
+    }
+
+    const string indexPath = "suffix_array_benchmark.sa";
+    optional<SuffixArrayIndex> built;
+    double buildTime = seconds([&] { built.emplace(text); });
+    double saveTime = seconds([&] { built->save(indexPath); });
+    built.reset();
+    SuffixArrayIndex loaded = SuffixArrayIndex::load(indexPath); // Warm-up read
+    double loadTime = seconds([&] { loaded = SuffixArrayIndex::load(indexPath); });
+    remove(indexPath.c_str());
+    cout << "Tekst " << megabytes << " MB, " << queryCount << " zapytan\n";
+    cout << "  budowa indeksu (SA-IS + LCP): " << buildTime << " s, zapis " << saveTime
+         << " s, wczytanie " << loadTime << " s\n";
+
+    vector<size_t> expected(queryCount);
+    auto report = [&](const char* name, double time) {
+        cout << "  " << name << ": " << time << " s (" << time / queryCount * 1e6
+             << " us/zapytanie)\n";
+    };
+    report("SuffixArrayIndex::count", seconds([&] {
+               for (size_t q = 0; q < queryCount; q++) expected[q] = loaded.count(queries[q]);
+           }));
+    size_t located = 0;
+    report("SuffixArrayIndex::locate", seconds([&] {
+               for (const string& query : queries) loaded.locate(query, [&](size_t) { located++; });
+           }));
+
+    size_t mismatches = 0;
+    report("CompactDFA (caly tekst na zapytanie)", seconds([&] {
+               for (size_t q = 0; q < queryCount; q++) {
+                   mismatches += CompactDFA(queries[q]).count(text) != expected[q];
+               }
+           }));
+    report("CompiledKMP (caly tekst na zapytanie)", seconds([&] {
+               for (size_t q = 0; q < queryCount; q++) {
+                   mismatches += CompiledKMP(queries[q]).count(text) != expected[q];
+               }
+           }));
+
+    size_t total = 0;
+    for (size_t found : expected) total += found;
+    cout << "Dopasowania: " << total << " (locate: " << located << "), niezgodnosci: "
+         << mismatches << "\n";
+    return mismatches == 0 && located == total ? 0 : 1;
+}
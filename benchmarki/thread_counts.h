@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+// Thread counts for scaling runs: 1, 2, 4, ... below maxThreads, then maxThreads itself
+// once, so a machine with 3, 6 or 12 cores still ends on its full count
+inline std::vector<int> threadCounts(int maxThreads) {
+    std::vector<int> counts;
+    for (int threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        counts.push_back(threads);
+        if (threads >= maxThreads) {
+            break;
+        }
+    }
+    return counts;
+}
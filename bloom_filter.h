@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Counting blocked Bloom filter: approximate membership with deletions, one cache line
+// per query. It answers "definitely absent" or "maybe present" for a 64-bit key hash.
+//
+// Every 64-byte block is 8 lanes of one uint64_t, and every lane holds 16 four-bit
+// counters. A key picks one block from its hash and one counter in each of the 8 lanes
+// (split block layout, as in Impala/Parquet). So a lookup reads a single cache line,
+// and the 8 lane checks are independent and branch-free, which suits SIMD. add()
+// increments the 8 counters and remove() decrements them. A counter that reaches 15
+// sticks there and is never decremented again: this can only cause extra "maybe"
+// answers, never a false "absent".
+//
+// The filter is sized for a key capacity and a target false positive rate. Past the
+// capacity it still works, but the rate grows; HashTable rebuilds it larger instead.
+class CountingBloomFilter {
+private:
+    static constexpr int LANES = 8;
+    static constexpr int COUNTERS_PER_LANE = 16;
+    static constexpr uint64_t COUNTER_MAX = 15;
+
+    struct alignas(64) Block {
+        uint64_t lanes[LANES];
+    };
+
+    // Odd multipliers that pick the counter in every lane from 32 bits of the hash
+    static constexpr uint32_t SALT[LANES] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                             0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                             0x9efc4947U, 0x5c6bfb31U};
+
+    std::vector<Block> blocks;
+    size_t keyCapacity = 0;
+
+    // fmix64 from MurmurHash3: the table's own hash (even AdditiveHash) picks buckets with
+    // its low bits, the filter should not depend on the same bits
+    static uint64_t mix(uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        return hash ^ (hash >> 33);
+    }
+
+    size_t blockIndex(uint64_t mixed) const {
+        return (size_t)(((__uint128_t)mixed * blocks.size()) >> 64);
+    }
+
+    static int shiftOf(uint64_t mixed, int lane) {
+        return (int)(((uint32_t)mixed * SALT[lane]) >> 28) * 4;
+    }
+
+    // Expected false positive rate with keysPerBlock keys per block on average: block
+    // loads are Poisson distributed, a lane's counter is set with 1 - (15/16)^load
+    static double falsePositiveRate(double keysPerBlock) {
+        double rate = 0;
+        double probability = std::exp(-keysPerBlock); // P(load = 0)
+        int limit = (int)(keysPerBlock + 12 * std::sqrt(keysPerBlock) + 20);
+        for (int load = 0; load <= limit; load++) {
+            double laneSet = 1 - std::pow(1.0 - 1.0 / COUNTERS_PER_LANE, load);
+            rate += probability * std::pow(laneSet, LANES);
+            probability *= keysPerBlock / (load + 1);
+        }
+        return rate;
+    }
+
+    // Largest average block load whose false positive rate stays within target
+    static double keysPerBlockFor(double target) {
+        double low = 0.01, high = 128;
+        for (int i = 0; i < 50; i++) {
+            double middle = (low + high) / 2;
+            (falsePositiveRate(middle) <= target ? low : high) = middle;
+        }
+        return low;
+    }
+
+public:
+    CountingBloomFilter() = default; // Disabled: no blocks, see enabled()
+
+    CountingBloomFilter(size_t capacity, double falsePositive) {
+        double keysPerBlock = keysPerBlockFor(falsePositive);
+        size_t blockCount = (size_t)std::ceil((capacity > 0 ? capacity : 1) / keysPerBlock);
+        blocks.assign(blockCount, Block{});
+        keyCapacity = (size_t)(blockCount * keysPerBlock);
+    }
+
+    bool enabled() const { return !blocks.empty(); }
+    size_t capacity() const { return keyCapacity; }
+    size_t memoryBytes() const { return blocks.size() * sizeof(Block); }
+
+    void prefetch(uint64_t hash) const { __builtin_prefetch(&blocks[blockIndex(mix(hash))]); }
+
+    // False: the key was never added (or all its copies were removed). True: maybe added
+    bool mayContain(uint64_t hash) const {
+        uint64_t mixed = mix(hash);
+        const Block& block = blocks[blockIndex(mixed)];
+        bool missing = false;
+        for (int lane = 0; lane < LANES; lane++) {
+            missing |= ((block.lanes[lane] >> shiftOf(mixed, lane)) & COUNTER_MAX) == 0;
+        }
+        return !missing;
+    }
+
+    void add(uint64_t hash) {
+        uint64_t mixed = mix(hash);
+        Block& block = blocks[blockIndex(mixed)];
+        for (int lane = 0; lane < LANES; lane++) {
+            int shift = shiftOf(mixed, lane);
+            if (((block.lanes[lane] >> shift) & COUNTER_MAX) != COUNTER_MAX) {
+                block.lanes[lane] += (uint64_t)1 << shift;
+            }
+        }
+    }
+
+    // Only for a hash that was added before; saturated counters stay saturated
+    void remove(uint64_t hash) {
+        uint64_t mixed = mix(hash);
+        Block& block = blocks[blockIndex(mixed)];
+        for (int lane = 0; lane < LANES; lane++) {
+            int shift = shiftOf(mixed, lane);
+            uint64_t counter = (block.lanes[lane] >> shift) & COUNTER_MAX;
+            if (counter != 0 && counter != COUNTER_MAX) {
+                block.lanes[lane] -= (uint64_t)1 << shift;
+            }
+        }
+    }
+};
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "hashers.h"
+
+// Epoch-based memory reclamation.
+// A reader announces the current global epoch while it traverses shared nodes. Removed
+// nodes are retired with the epoch of their removal and freed once the global epoch has
+// advanced twice past it - by then no reader can still hold a pointer to them.
+class EpochReclaimer {
+private:
+    static const int MAX_THREADS = 256;
+    static const uint64_t IDLE = 0;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{IDLE};
+    };
+
+    struct Retired {
+        uint64_t epoch;
+        void* object;
+        void (*deleter)(void*);
+    };
+
+    std::atomic<uint64_t> globalEpoch{1};
+    Slot slots[MAX_THREADS];
+    std::mutex retiredMutex;
+    std::vector<Retired> retired;
+
+    // Slot index of a thread, shared by every reclaimer. It is claimed on the thread's
+    // first Guard and given back when the thread exits, so MAX_THREADS limits only the
+    // threads alive at the same time, not all threads ever started
+    class ThreadSlot {
+    private:
+        static inline std::atomic<bool> taken[MAX_THREADS] = {};
+        int index = -1;
+
+    public:
+        ThreadSlot() {
+            for (int i = 0; i < MAX_THREADS; i++) {
+                bool expected = false;
+                if (!taken[i].load(std::memory_order_relaxed) &&
+                    taken[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    index = i;
+                    return;
+                }
+            }
+            throw std::runtime_error("EpochReclaimer: too many threads");
+        }
+        // The thread's Guards are gone by now, so its slot in every reclaimer is IDLE
+        ~ThreadSlot() { taken[index].store(false, std::memory_order_release); }
+
+        int get() const { return index; }
+    };
+
+    static int threadIndex() {
+        thread_local ThreadSlot slot;
+        return slot.get();
+    }
+
+    // Advance the epoch if every active reader has seen the current one, then free
+    // what is old enough. Caller holds retiredMutex.
+    void collect() {
+        uint64_t epoch = globalEpoch.load();
+        bool canAdvance = true;
+        for (int i = 0; i < MAX_THREADS; i++) {
+            uint64_t seen = slots[i].epoch.load();
+            if (seen != IDLE && seen != epoch) {
+                canAdvance = false;
+                break;
+            }
+        }
+        if (canAdvance) {
+            globalEpoch.store(++epoch);
+        }
+        size_t kept = 0;
+        for (size_t i = 0; i < retired.size(); i++) {
+            if (retired[i].epoch + 2 <= epoch) {
+                retired[i].deleter(retired[i].object);
+            } else {
+                retired[kept++] = retired[i];
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    // RAII read-side critical section
+    class Guard {
+    private:
+        Slot& slot;
+
+    public:
+        Guard(EpochReclaimer& reclaimer) : slot(reclaimer.slots[threadIndex()]) {
+            slot.epoch.store(reclaimer.globalEpoch.load(), std::memory_order_relaxed);
+            // The announcement must be visible before any shared pointer is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Guard() { slot.epoch.store(IDLE, std::memory_order_release); }
+    };
+
+    EpochReclaimer() = default;
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    ~EpochReclaimer() {
+        for (const Retired& item : retired) {
+            item.deleter(item.object);
+        }
+    }
+
+    template <typename T>
+    void retire(T* object) {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        retired.push_back({globalEpoch.load(), object, [](void* p) { delete (T*)p; }});
+        if (retired.size() >= 64) {
+            collect();
+        }
+    }
+
+    // Retire many objects under one lock and with at most one collect()
+    template <typename T>
+    void retireAll(const std::vector<T*>& objects) {
+        std::lock_guard<std::mutex> lock(retiredMutex);
+        uint64_t epoch = globalEpoch.load();
+        for (T* object : objects) {
+            retired.push_back({epoch, object, [](void* p) { delete (T*)p; }});
+        }
+        if (retired.size() >= 64) {
+            collect();
+        }
+    }
+};
+
+// Thread-safe hash set of strings.
+// - search is lock-free: it only follows atomic pointers inside an epoch guard,
+// - insert/erase lock one of STRIPES mutexes, chosen by the key's hash,
+// - removed nodes and old bucket arrays are freed through EpochReclaimer.
+// Growing copies the nodes into a new bucket array while holding every stripe lock, so
+// readers that are still on the old array keep seeing a consistent snapshot.
+template <typename Hasher = WyHash>
+class ConcurrentHashTable {
+private:
+    static const size_t STRIPES = 64; // Power of two, not larger than the bucket count
+
+    struct CNode {
+        std::string key;
+        uint64_t hash;
+        std::atomic<CNode*> next;
+
+        CNode(const std::string& keyValue, uint64_t hashValue, CNode* nextNode)
+            : key(keyValue), hash(hashValue), next(nextNode) {}
+    };
+
+    struct BucketArray {
+        size_t size; // Power of two
+        std::atomic<CNode*>* buckets;
+
+        BucketArray(size_t bucketCount) : size(bucketCount) {
+            buckets = new std::atomic<CNode*>[size];
+            for (size_t i = 0; i < size; i++) {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+        ~BucketArray() { delete[] buckets; }
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+    };
+
+    std::atomic<BucketArray*> current;
+    Stripe stripes[STRIPES];
+    std::atomic<size_t> count{0};
+    double maxLoadFactor;
+    Hasher hasher;
+    EpochReclaimer reclaimer;
+
+    std::mutex& stripeFor(uint64_t hash) { return stripes[hash & (STRIPES - 1)].mutex; }
+
+    // Bucket array to use while holding a stripe lock (resize holds all of them)
+    BucketArray* lockedArray() const { return current.load(std::memory_order_relaxed); }
+
+    void grow(size_t observedSize) {
+        for (size_t i = 0; i < STRIPES; i++) {
+            stripes[i].mutex.lock();
+        }
+        BucketArray* old = lockedArray();
+        std::vector<CNode*> oldNodes; // Retired in one batch after the stripes are released
+        bool grew = old->size == observedSize; // Nobody else grew the table in the meantime
+        if (grew) {
+            oldNodes.reserve(count.load(std::memory_order_relaxed));
+            BucketArray* bigger = new BucketArray(old->size * 2);
+            size_t mask = bigger->size - 1;
+            for (size_t i = 0; i < old->size; i++) {
+                CNode* node = old->buckets[i].load(std::memory_order_relaxed);
+                while (node) {
+                    std::atomic<CNode*>& head = bigger->buckets[node->hash & mask];
+                    CNode* copy = new CNode(node->key, node->hash, head.load(std::memory_order_relaxed));
+                    head.store(copy, std::memory_order_relaxed);
+                    CNode* next = node->next.load(std::memory_order_relaxed);
+                    oldNodes.push_back(node);
+                    node = next;
+                }
+            }
+            current.store(bigger, std::memory_order_release);
+        }
+        for (size_t i = STRIPES; i-- > 0;) {
+            stripes[i].mutex.unlock();
+        }
+        if (grew) {
+            reclaimer.retireAll(oldNodes);
+            reclaimer.retire(old);
+        }
+    }
+
+public:
+    ConcurrentHashTable(size_t tableSize = 1024, double maxLoad = 1.0) : maxLoadFactor(maxLoad) {
+        size_t buckets = STRIPES;
+        while (buckets < tableSize) {
+            buckets *= 2;
+        }
+        current.store(new BucketArray(buckets));
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    ~ConcurrentHashTable() {
+        BucketArray* array = current.load();
+        for (size_t i = 0; i < array->size; i++) {
+            CNode* node = array->buckets[i].load();
+            while (node) {
+                CNode* next = node->next.load();
+                delete node;
+                node = next;
+            }
+        }
+        delete array;
+    }
+
+    // Insert a key, returns false when it was already present
+    bool insert(const std::string& key) {
+        uint64_t hash = hasher(key);
+        size_t observedSize;
+        {
+            std::lock_guard<std::mutex> lock(stripeFor(hash));
+            BucketArray* array = lockedArray();
+            std::atomic<CNode*>& head = array->buckets[hash & (array->size - 1)];
+            for (CNode* node = head.load(std::memory_order_relaxed); node;
+                 node = node->next.load(std::memory_order_relaxed)) {
+                if (node->hash == hash && node->key == key) {
+                    return false;
+                }
+            }
+            // Fully built node is published with a release store
+            head.store(new CNode(key, hash, head.load(std::memory_order_relaxed)),
+                       std::memory_order_release);
+            observedSize = array->size;
+        }
+        if (count.fetch_add(1, std::memory_order_relaxed) + 1 > maxLoadFactor * observedSize) {
+            grow(observedSize);
+        }
+        return true;
+    }
+
+    // Search for a key (lock-free)
+    bool search(const std::string& key) {
+        uint64_t hash = hasher(key);
+        EpochReclaimer::Guard guard(reclaimer);
+        BucketArray* array = current.load(std::memory_order_acquire);
+        CNode* node = array->buckets[hash & (array->size - 1)].load(std::memory_order_acquire);
+        while (node) {
+            if (node->hash == hash && node->key == key) {
+                return true;
+            }
+            node = node->next.load(std::memory_order_acquire);
+        }
+        return false;
+    }
+
+    // Erase a key, returns false when the key was not present
+    bool erase(const std::string& key) {
+        uint64_t hash = hasher(key);
+        std::lock_guard<std::mutex> lock(stripeFor(hash));
+        BucketArray* array = lockedArray();
+        std::atomic<CNode*>* link = &array->buckets[hash & (array->size - 1)];
+        for (CNode* node = link->load(std::memory_order_relaxed); node;
+             node = link->load(std::memory_order_relaxed)) {
+            if (node->hash == hash && node->key == key) {
+                // Readers already on this node can still follow its next pointer
+                link->store(node->next.load(std::memory_order_relaxed), std::memory_order_release);
+                count.fetch_sub(1, std::memory_order_relaxed);
+                reclaimer.retire(node);
+                return true;
+            }
+            link = &node->next;
+        }
+        return false;
+    }
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,535 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include "arena.h"
+#include "bloom_filter.h"
+#include "hashers.h"
+#include "stats.h"
+
+// How HashTable keeps the bytes of inserted keys
+enum class KeyStorage {
+    Copy,   // Copied into the table's StringSlab (default)
+    Intern, // Copied once: a duplicate key shares the bytes of the copy already stored,
+            // at the cost of a chain walk on every insert
+    Borrow  // Only a view is stored: the caller keeps the buffer alive and unchanged
+};
+
+// Nodes and key bytes are bump-allocated from the table's Arena, so a Node is trivially
+// destructible and the key is a pointer into the table's StringSlab.
+struct Node {
+    const char* key; // Not null-terminated, see length. Points into the StringSlab or,
+                     // with KeyStorage::Borrow, into the caller's buffer
+    size_t length;
+    uint64_t hash; // Cached full hash, so rehashing does not hash the key again
+    Node* next;
+
+    Node(const char* keyData, size_t keyLength, uint64_t hashValue)
+        : key(keyData), length(keyLength), hash(hashValue), next(nullptr) {}
+
+    std::string_view keyView() const { return std::string_view(key, length); }
+
+    bool matches(std::string_view other, uint64_t otherHash) const {
+        return hash == otherHash && length == other.size() &&
+               memcmp(key, other.data(), length) == 0;
+    }
+};
+
+// Snapshot returned by HashTable::stats(). The counters (lookups, collisions, probes) are
+// only collected when built with ALGORYTMY_STATS (see stats.h), otherwise they stay zero;
+// load factor and chain lengths are computed from the table when the snapshot is taken.
+struct HashTableStats {
+    int keys = 0;
+    int buckets = 0; // Both bucket arrays while resizing
+    double loadFactor = 0;
+    uint64_t lookups = 0;    // Chain walks: search, erase, duplicate check of Intern inserts
+    uint64_t collisions = 0; // Inserts into a bucket that already had a node
+    Histogram<> probes;      // Nodes compared per lookup
+    Histogram<> chains;      // Chain length of every bucket
+    int longestChain = 0;
+    size_t filterBytes = 0;            // 0 when the filter is off
+    uint64_t filterRejections = 0;     // Lookups answered by the filter alone
+    uint64_t filterFalsePositives = 0; // Lookups the filter passed that still missed
+
+    void print(std::ostream& out) const {
+        out << "Klucze: " << keys << ", kubelki: " << buckets
+            << ", wspolczynnik zapelnienia: " << loadFactor << "\n";
+        out << "Wyszukania: " << lookups << ", kolizje przy wstawianiu: " << collisions << "\n";
+        out << "Porownania na wyszukanie:";
+        probes.print(out);
+        out << "\nDlugosci lancuchow (najdluzszy " << longestChain << "):";
+        chains.print(out);
+        out << "\n";
+        if (filterBytes) {
+            out << "Filtr: " << filterBytes << " B, odrzucone wyszukania: " << filterRejections
+                << ", falszywe trafienia: " << filterFalsePositives << "\n";
+        }
+    }
+};
+
+// Separate chaining hash table: every bucket is a singly linked list of nodes.
+// Hasher is pluggable (see hashers.h), e.g. HashTable<AdditiveHash> gives the old behaviour.
+//
+// The table grows when the load factor would exceed maxLoadFactor. Like in Redis, the
+// resize is incremental: a second bucket array is allocated and every following
+// operation migrates REHASH_STEP buckets, so no single insert pays for an O(n) rehash.
+//
+// Nodes come from an ObjectPool and keys from a StringSlab, both backed by one Arena:
+// an insert is a bump allocation and the destructor frees only the arena's chunks.
+// Keys are taken as std::string_view, so a slice of a larger buffer needs no temporary
+// std::string; with KeyStorage::Borrow the key bytes are not copied at all.
+//
+// enableFilter() puts a CountingBloomFilter (bloom_filter.h) in front of the chains: most
+// lookups of absent keys are rejected after reading one cache line, without walking a
+// chain or comparing strings. The filter works on the cached Node::hash, follows every
+// insert and erase, and is rebuilt twice as large when the key count outgrows it.
+template <typename Hasher = WyHash>
+class HashTable {
+private:
+    static const int REHASH_STEP = 4;        // Buckets migrated per operation
+    static const int REHASH_EMPTY_VISITS = 40; // Max empty buckets skipped per step
+    static constexpr size_t BATCH_SIZE = 16;   // Keys in flight in searchBatch
+
+    Node** table; // Array of pointers to nodes
+    int size;
+    Node** newTable; // Bucket array being filled during a resize (nullptr otherwise)
+    int newSize;
+    int rehashIndex; // Next bucket of table to migrate, -1 when not resizing
+    int count;       // Number of stored keys
+    double maxLoadFactor;
+    KeyStorage keyStorage;
+    Hasher hasher;
+    Arena arena;
+    ObjectPool<Node> nodePool;
+    StringSlab keys;
+    CountingBloomFilter filter; // Disabled unless enableFilter() was called
+    double filterFalsePositive = 0;
+    mutable Histogram<> probeHistogram; // Only updated with STATS_ENABLED
+    uint64_t collisionCount = 0;
+    uint64_t filterRejections = 0, filterFalsePositives = 0; // Only with STATS_ENABLED
+
+    void recordProbes(uint64_t probes) const {
+        if constexpr (STATS_ENABLED) {
+            probeHistogram.record(probes);
+        }
+    }
+
+    // Hash function
+    uint64_t hashFunction(std::string_view key) const {
+        return hasher(key);
+    }
+
+    static int bucketIndex(uint64_t hash, int buckets) {
+        return (int)(hash % (uint64_t)buckets);
+    }
+
+    // calloc instead of new[] + loop: large arrays come straight from zeroed pages,
+    // so starting a resize does not touch every new bucket up front
+    static Node** allocateBuckets(int buckets) {
+        Node** result = (Node**)std::calloc(buckets, sizeof(Node*));
+        if (!result) {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    void startRehash(int buckets) {
+        newTable = allocateBuckets(buckets);
+        newSize = buckets;
+        rehashIndex = 0;
+    }
+
+    // Migrate up to REHASH_STEP non-empty buckets from table to newTable
+    void rehashStep() {
+        if (rehashIndex < 0) {
+            return;
+        }
+        int moved = 0;
+        int emptyVisits = 0;
+        while (rehashIndex < size && moved < REHASH_STEP && emptyVisits < REHASH_EMPTY_VISITS) {
+            Node* current = table[rehashIndex];
+            if (!current) {
+                emptyVisits++;
+            }
+            while (current) {
+                Node* next = current->next;
+                int index = bucketIndex(current->hash, newSize);
+                current->next = newTable[index];
+                newTable[index] = current;
+                current = next;
+            }
+            if (table[rehashIndex]) {
+                moved++;
+            }
+            table[rehashIndex] = nullptr;
+            rehashIndex++;
+        }
+        if (rehashIndex == size) {
+            // Every bucket migrated: newTable becomes the table
+            std::free(table);
+            table = newTable;
+            size = newSize;
+            newTable = nullptr;
+            newSize = 0;
+            rehashIndex = -1;
+        }
+    }
+
+    Node* findNode(Node** buckets, int bucketCount, std::string_view key, uint64_t hash) const {
+        Node* current = buckets[bucketIndex(hash, bucketCount)];
+        uint64_t probes = 0;
+        while (current) {
+            probes++;
+            if (current->matches(key, hash)) {
+                recordProbes(probes);
+                return current; // Key found
+            }
+            current = current->next;
+        }
+        recordProbes(probes);
+        return nullptr;
+    }
+
+    void rebuildFilter(size_t capacity) {
+        filter = CountingBloomFilter(capacity, filterFalsePositive);
+        for (int i = 0; i < size + newSize; i++) {
+            for (Node* current = i < size ? table[i] : newTable[i - size]; current;
+                 current = current->next) {
+                filter.add(current->hash);
+            }
+        }
+    }
+
+    // True when the filter proves the key absent, so the chains need not be searched
+    bool filterRejects(uint64_t hash) {
+        if (!filter.enabled() || filter.mayContain(hash)) {
+            return false;
+        }
+        if constexpr (STATS_ENABLED) {
+            filterRejections++;
+        }
+        return true;
+    }
+
+    void recordFilterMiss() {
+        if constexpr (STATS_ENABLED) {
+            filterFalsePositives += filter.enabled();
+        }
+    }
+
+    bool eraseFrom(Node** buckets, int bucketCount, std::string_view key, uint64_t hash) {
+        Node** link = &buckets[bucketIndex(hash, bucketCount)];
+        uint64_t probes = 0;
+        while (*link) {
+            Node* current = *link;
+            probes++;
+            if (current->matches(key, hash)) {
+                *link = current->next;
+                nodePool.release(current);
+                recordProbes(probes);
+                return true;
+            }
+            link = &current->next;
+        }
+        recordProbes(probes);
+        return false;
+    }
+
+public:
+    // Constructor
+    HashTable(int tableSize, double maxLoad = 1.0, KeyStorage storage = KeyStorage::Copy)
+        : size(tableSize > 0 ? tableSize : 1), newTable(nullptr), newSize(0), rehashIndex(-1),
+          count(0), maxLoadFactor(maxLoad), keyStorage(storage), nodePool(arena), keys(arena) {
+        table = allocateBuckets(size);
+    }
+
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
+    // Destructor
+    ~HashTable() {
+        // Nodes and keys are released together with the arena
+        std::free(table);
+        std::free(newTable);
+    }
+
+    // Insert a key
+    void insert(std::string_view key) {
+        rehashStep();
+        if (rehashIndex < 0 && count + 1 > maxLoadFactor * size) {
+            startRehash(size * 2);
+        }
+        uint64_t hash = hashFunction(key);
+        // While resizing, new keys go straight to the new bucket array
+        Node** buckets = rehashIndex >= 0 ? newTable : table;
+        int index = bucketIndex(hash, rehashIndex >= 0 ? newSize : size);
+        const char* keyData = key.data();
+        if (keyStorage == KeyStorage::Intern) {
+            // A duplicate key shares the bytes already stored for the first copy
+            Node* existing = findNode(table, size, key, hash);
+            if (!existing && rehashIndex >= 0) {
+                existing = findNode(newTable, newSize, key, hash);
+            }
+            keyData = existing ? existing->key : keys.store(key.data(), key.size());
+        } else if (keyStorage == KeyStorage::Copy) {
+            keyData = keys.store(key.data(), key.size());
+        }
+        Node* newNode = new (nodePool.allocate()) Node(keyData, key.size(), hash);
+        if (!buckets[index]) {
+            buckets[index] = newNode; // Insert as the first node
+        } else {
+            // Collision: Add to the front of the linked list
+            newNode->next = buckets[index];
+            buckets[index] = newNode;
+            if constexpr (STATS_ENABLED) {
+                collisionCount++;
+            }
+        }
+        count++;
+        if (filter.enabled()) {
+            if ((size_t)count > filter.capacity()) {
+                rebuildFilter((size_t)count * 2); // The new node is added by the walk
+            } else {
+                filter.add(hash);
+            }
+        }
+    }
+
+    // Search for a key
+    bool search(std::string_view key) {
+        rehashStep();
+        uint64_t hash = hashFunction(key);
+        if (filterRejects(hash)) {
+            return false;
+        }
+        if (findNode(table, size, key, hash) ||
+            (rehashIndex >= 0 && findNode(newTable, newSize, key, hash))) {
+            return true;
+        }
+        recordFilterMiss();
+        return false;
+    }
+
+    // Search for many keys at once: results[i] tells whether keys[i] is present, the
+    // return value is the number of keys found. Keys are processed in groups of BATCH_SIZE:
+    // hash all of them and prefetch their buckets, then prefetch the first node of every
+    // chain, and only then compare keys - the cache misses of a group overlap instead of
+    // stalling one after another. With the filter on, the filter blocks are prefetched
+    // first and only keys that pass it touch the buckets.
+    size_t searchBatch(std::span<const std::string_view> keys, std::span<bool> results) {
+        rehashStep();
+        size_t found = 0;
+        uint64_t hashes[BATCH_SIZE];
+        int indices[BATCH_SIZE];
+        Node* heads[BATCH_SIZE];
+        bool rejected[BATCH_SIZE] = {};
+        for (size_t start = 0; start < keys.size(); start += BATCH_SIZE) {
+            size_t batch = std::min(BATCH_SIZE, keys.size() - start);
+            for (size_t i = 0; i < batch; i++) {
+                hashes[i] = hashFunction(keys[start + i]);
+                indices[i] = bucketIndex(hashes[i], size);
+                if (filter.enabled()) {
+                    filter.prefetch(hashes[i]);
+                } else {
+                    __builtin_prefetch(&table[indices[i]]);
+                }
+            }
+            if (filter.enabled()) {
+                for (size_t i = 0; i < batch; i++) {
+                    rejected[i] = filterRejects(hashes[i]);
+                    if (!rejected[i]) {
+                        __builtin_prefetch(&table[indices[i]]);
+                    }
+                }
+            }
+            for (size_t i = 0; i < batch; i++) {
+                heads[i] = rejected[i] ? nullptr : table[indices[i]];
+                if (heads[i]) {
+                    __builtin_prefetch(heads[i]); // Key bytes follow the node in the arena
+                }
+            }
+            for (size_t i = 0; i < batch; i++) {
+                if (rejected[i]) {
+                    results[start + i] = false;
+                    continue;
+                }
+                bool hit = false;
+                uint64_t probes = 0;
+                for (Node* current = heads[i]; current; current = current->next) {
+                    probes++;
+                    if (current->matches(keys[start + i], hashes[i])) {
+                        hit = true;
+                        break;
+                    }
+                }
+                recordProbes(probes);
+                if (!hit && rehashIndex >= 0) {
+                    hit = findNode(newTable, newSize, keys[start + i], hashes[i]) != nullptr;
+                }
+                if (!hit) {
+                    recordFilterMiss();
+                }
+                results[start + i] = hit;
+                found += hit;
+            }
+        }
+        return found;
+    }
+
+    // Erase one occurrence of a key, returns false when the key was not present
+    bool erase(std::string_view key) {
+        rehashStep();
+        uint64_t hash = hashFunction(key);
+        if (eraseFrom(table, size, key, hash) ||
+            (rehashIndex >= 0 && eraseFrom(newTable, newSize, key, hash))) {
+            count--;
+            if (filter.enabled()) {
+                filter.remove(hash);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    int keyCount() const { return count; }
+    double loadFactor() const { return (double)count / (rehashIndex >= 0 ? newSize : size); }
+    void setMaxLoadFactor(double maxLoad) { maxLoadFactor = maxLoad; }
+    bool isRehashing() const { return rehashIndex >= 0; }
+
+    // Put a CountingBloomFilter in front of the chains, sized for at least the current
+    // keys (and what reserve() asked for) at the given false positive rate. About 5 bytes
+    // per key at 1%; lookups of absent keys then mostly cost one hash and one cache line
+    void enableFilter(double falsePositiveRate = 0.01, size_t expectedKeys = 0) {
+        filterFalsePositive = falsePositiveRate;
+        rebuildFilter(std::max({expectedKeys, (size_t)count * 2, (size_t)1024}));
+    }
+
+    void disableFilter() { filter = CountingBloomFilter(); }
+    bool filterEnabled() const { return filter.enabled(); }
+
+    // Prepare for a bulk load of expectedKeys keys: size the buckets now (finishing any
+    // resize) and reserve arena space, so the load itself does no malloc calls
+    void reserve(int expectedKeys, size_t averageKeyLength = 16) {
+        while (rehashIndex >= 0) {
+            rehashStep();
+        }
+        int needed = (int)(expectedKeys / maxLoadFactor) + 1;
+        if (needed > size) {
+            startRehash(needed);
+            while (rehashIndex >= 0) {
+                rehashStep();
+            }
+        }
+        if (filter.enabled() && (size_t)expectedKeys > filter.capacity()) {
+            rebuildFilter(expectedKeys);
+        }
+        int remaining = expectedKeys - count;
+        if (remaining > 0) {
+            arena.reserve((size_t)remaining * (sizeof(Node) + alignof(Node) + averageKeyLength));
+        }
+    }
+
+    // Counters and chain-length histogram; cheap enough to dump periodically during a
+    // run, the chain walk is O(buckets + keys)
+    HashTableStats stats() const {
+        HashTableStats result;
+        result.keys = count;
+        result.buckets = size + newSize;
+        result.loadFactor = loadFactor();
+        result.probes = probeHistogram;
+        result.lookups = probeHistogram.total();
+        result.collisions = collisionCount;
+        result.filterBytes = filter.memoryBytes();
+        result.filterRejections = filterRejections;
+        result.filterFalsePositives = filterFalsePositives;
+        for (int i = 0; i < size + newSize; i++) {
+            int length = 0;
+            for (Node* current = i < size ? table[i] : newTable[i - size]; current;
+                 current = current->next) {
+                length++;
+            }
+            result.chains.record(length);
+            result.longestChain = std::max(result.longestChain, length);
+        }
+        return result;
+    }
+
+    void resetStats() {
+        probeHistogram = Histogram<>();
+        collisionCount = 0;
+        filterRejections = 0;
+        filterFalsePositives = 0;
+    }
+
+    // Call visit(std::string_view key) for every stored key
+    template <typename Visitor>
+    void forEachKey(Visitor visit) const {
+        for (int i = 0; i < size + newSize; i++) {
+            Node* current = i < size ? table[i] : newTable[i - size];
+            for (; current; current = current->next) {
+                visit(current->keyView());
+            }
+        }
+    }
+
+    // Display the hash table
+    void display() {
+        for (int i = 0; i < size; i++) {
+            std::cout << i << ": ";
+            Node* current = table[i];
+            while (current) {
+                std::cout << current->keyView() << " -> ";
+                current = current->next;
+            }
+            std::cout << "NULL\n";
+        }
+        if (rehashIndex >= 0) {
+            std::cout << "(w trakcie powiekszania, przeniesiono " << rehashIndex << " z "
+                      << size << " kubelkow)\n";
+            for (int i = 0; i < newSize; i++) {
+                std::cout << i << "': ";
+                Node* current = newTable[i];
+                while (current) {
+                    std::cout << current->keyView() << " -> ";
+                    current = current->next;
+                }
+                std::cout << "NULL\n";
+            }
+        }
+    }
+
+    // Print bucket distribution and chain length histogram
+    void printBucketReport() const {
+        std::map<int, int> histogram; // chain length -> number of buckets
+        int keys = 0;
+        int longest = 0;
+        int buckets = size + newSize;
+        for (int i = 0; i < buckets; i++) {
+            int length = 0;
+            Node* current = i < size ? table[i] : newTable[i - size];
+            for (; current; current = current->next) {
+                length++;
+            }
+            histogram[length]++;
+            keys += length;
+            if (length > longest) longest = length;
+        }
+        int used = buckets - histogram[0];
+        std::cout << "Kubelki: " << buckets << ", zajete: " << used << ", klucze: " << keys
+                  << ", wspolczynnik zapelnienia: " << loadFactor() << "\n";
+        std::cout << "Najdluzszy lancuch: " << longest << ", srednia dlugosc (niepuste): "
+                  << (used ? (double)keys / used : 0.0) << "\n";
+        std::cout << "Histogram dlugosci lancuchow:\n";
+        for (const auto& entry : histogram) {
+            std::cout << "  " << entry.first << ": " << entry.second << "\n";
+        }
+    }
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "hash_table.h"
+#include "hashers.h"
+
+// Read-only hash table file that is queried in place through mmap.
+//
+// Layout (little-endian, every position is an offset from the start of the file, so the
+// file can be mapped at any address and shared between processes via the page cache):
+//
+//   Header                                  64 bytes
+//   uint32_t bucketStart[bucketCount + 1]   entries of bucket b: [bucketStart[b], bucketStart[b+1])
+//   Entry    entries[keyCount]              grouped by bucket, 8-byte aligned
+//   char     strings[]                      key bytes, Entry::keyOffset is relative to here
+//
+// Keys are hashed with WyHash and the seed stored in the header.
+class MappedHashTable {
+public:
+    struct Header {
+        char magic[8]; // "HTFILE1"
+        uint32_t endianCheck;
+        uint32_t bucketCount;
+        uint64_t keyCount;
+        uint64_t seed;
+        uint64_t bucketsOffset;
+        uint64_t entriesOffset;
+        uint64_t stringsOffset;
+        uint64_t fileSize;
+    };
+
+    struct Entry {
+        uint64_t hash;
+        uint32_t keyOffset;
+        uint32_t keyLength;
+    };
+
+private:
+    static constexpr char MAGIC[8] = "HTFILE1";
+    static const uint32_t ENDIAN_CHECK = 0x01020304;
+
+    const char* base;
+    size_t mappedSize;
+    const Header* header;
+    const uint32_t* bucketStart;
+    const Entry* entries;
+    const char* strings;
+    uint64_t stringsSize;
+
+    static uint64_t alignTo8(uint64_t value) { return (value + 7) & ~(uint64_t)7; }
+
+    // path is the temporary file: on failure it is removed, the target stays untouched
+    static void writeAll(FILE* file, const void* data, size_t bytes, const std::string& path) {
+        if (bytes && fwrite(data, 1, bytes, file) != bytes) {
+            fclose(file);
+            remove(path.c_str());
+            throw std::runtime_error("MappedHashTable: write failed: " + path);
+        }
+    }
+
+    // O(1) checks of the header: every offset and count must stay inside the mapping. The
+    // bucket ranges and the keys are checked by search(), only for the buckets it reads,
+    // so opening does not touch the rest of the file
+    bool validate() const {
+        if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->endianCheck != ENDIAN_CHECK ||
+            header->fileSize != mappedSize || header->bucketCount == 0) {
+            return false;
+        }
+        uint64_t bucketBytes = ((uint64_t)header->bucketCount + 1) * sizeof(uint32_t);
+        return header->bucketsOffset >= sizeof(Header) &&
+               header->bucketsOffset % alignof(uint32_t) == 0 &&
+               header->bucketsOffset <= mappedSize &&
+               bucketBytes <= mappedSize - header->bucketsOffset &&
+               header->entriesOffset >= header->bucketsOffset + bucketBytes &&
+               header->entriesOffset % alignof(Entry) == 0 && header->entriesOffset <= mappedSize &&
+               header->keyCount <= (mappedSize - header->entriesOffset) / sizeof(Entry) &&
+               header->stringsOffset >= header->entriesOffset + header->keyCount * sizeof(Entry) &&
+               header->stringsOffset <= mappedSize;
+    }
+
+    [[noreturn]] static void corrupt() {
+        throw std::runtime_error("MappedHashTable: corrupt hash table file");
+    }
+
+public:
+    // Build step: write every key of `keys` (anything with forEachKey) to `path`.
+    // The table goes to path + ".tmp" first and is renamed over `path` when complete:
+    // processes that still map the old file keep its inode, truncating it in place would
+    // make their next access fault with SIGBUS
+    template <typename Table>
+    static void write(const Table& keys, const std::string& path, uint64_t seed = 0) {
+        std::vector<std::string_view> all;
+        keys.forEachKey([&](std::string_view key) { all.push_back(key); });
+
+        uint32_t bucketCount = all.empty() ? 1 : (uint32_t)all.size();
+        std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+        std::vector<uint64_t> hashes(all.size());
+        for (size_t i = 0; i < all.size(); i++) {
+            hashes[i] = WyHash::hash(all[i].data(), all[i].size(), seed);
+            bucketStart[hashes[i] % bucketCount + 1]++;
+        }
+        for (uint32_t b = 0; b < bucketCount; b++) {
+            bucketStart[b + 1] += bucketStart[b]; // Counts -> prefix sums
+        }
+
+        std::vector<Entry> entries(all.size());
+        std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        std::string strings;
+        for (size_t i = 0; i < all.size(); i++) {
+            if (strings.size() + all[i].size() > UINT32_MAX) {
+                throw std::runtime_error("MappedHashTable: keys exceed 4 GB");
+            }
+            Entry& entry = entries[fill[hashes[i] % bucketCount]++];
+            entry.hash = hashes[i];
+            entry.keyOffset = (uint32_t)strings.size();
+            entry.keyLength = (uint32_t)all[i].size();
+            strings.append(all[i]);
+        }
+
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.endianCheck = ENDIAN_CHECK;
+        header.bucketCount = bucketCount;
+        header.keyCount = all.size();
+        header.seed = seed;
+        header.bucketsOffset = sizeof(Header);
+        header.entriesOffset = alignTo8(header.bucketsOffset + bucketStart.size() * sizeof(uint32_t));
+        header.stringsOffset = header.entriesOffset + entries.size() * sizeof(Entry);
+        header.fileSize = header.stringsOffset + strings.size();
+
+        std::string tmpPath = path + ".tmp";
+        FILE* file = fopen(tmpPath.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("MappedHashTable: cannot create " + tmpPath);
+        }
+        static const char padding[8] = {0};
+        uint64_t afterBuckets = header.bucketsOffset + bucketStart.size() * sizeof(uint32_t);
+        writeAll(file, &header, sizeof(header), tmpPath);
+        writeAll(file, bucketStart.data(), bucketStart.size() * sizeof(uint32_t), tmpPath);
+        writeAll(file, padding, header.entriesOffset - afterBuckets, tmpPath);
+        writeAll(file, entries.data(), entries.size() * sizeof(Entry), tmpPath);
+        writeAll(file, strings.data(), strings.size(), tmpPath);
+        bool flushed = fflush(file) == 0 && fsync(fileno(file)) == 0;
+        if (fclose(file) != 0 || !flushed) {
+            remove(tmpPath.c_str());
+            throw std::runtime_error("MappedHashTable: write failed: " + tmpPath);
+        }
+        if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+            remove(tmpPath.c_str());
+            throw std::runtime_error("MappedHashTable: cannot replace " + path);
+        }
+    }
+
+    // Map the file; nothing is copied and pages are loaded on first access. Opening only
+    // checks the header, so it takes the same time for any number of keys
+    explicit MappedHashTable(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("MappedHashTable: cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(Header)) {
+            close(fd);
+            throw std::runtime_error("MappedHashTable: not a hash table file: " + path);
+        }
+        mappedSize = (size_t)info.st_size;
+        void* mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd); // The mapping stays valid after closing the descriptor
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("MappedHashTable: mmap failed: " + path);
+        }
+        base = (const char*)mapped;
+        header = (const Header*)base;
+        if (!validate()) {
+            munmap(mapped, mappedSize);
+            throw std::runtime_error("MappedHashTable: corrupt or foreign file: " + path);
+        }
+        bucketStart = (const uint32_t*)(base + header->bucketsOffset);
+        entries = (const Entry*)(base + header->entriesOffset);
+        strings = base + header->stringsOffset;
+        stringsSize = mappedSize - header->stringsOffset;
+    }
+
+    MappedHashTable(const MappedHashTable&) = delete;
+    MappedHashTable& operator=(const MappedHashTable&) = delete;
+
+    ~MappedHashTable() { munmap((void*)base, mappedSize); }
+
+    // Search for a key. Throws std::runtime_error if the bucket it reads points outside
+    // the file - the file was damaged after it passed the header checks
+    bool search(std::string_view key) const {
+        uint64_t hash = WyHash::hash(key.data(), key.size(), header->seed);
+        uint32_t bucket = (uint32_t)(hash % header->bucketCount);
+        uint32_t first = bucketStart[bucket];
+        uint32_t last = bucketStart[bucket + 1];
+        if (first > last || last > header->keyCount) {
+            corrupt();
+        }
+        for (uint32_t i = first; i < last; i++) {
+            const Entry& entry = entries[i];
+            if (entry.hash == hash && entry.keyLength == key.size()) {
+                if ((uint64_t)entry.keyOffset + entry.keyLength > stringsSize) {
+                    corrupt();
+                }
+                if (memcmp(strings + entry.keyOffset, key.data(), key.size()) == 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    uint64_t keyCount() const { return header->keyCount; }
+};
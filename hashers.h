@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+
+// Hash functions for HashTable / FlatHashTable.
+// A hasher is any type with `uint64_t operator()(std::string_view) const`.
+
+// The original additive hash: sum of (lowercase letter - 'a' + 1).
+// Kept for comparison only - every anagram lands in the same bucket.
+struct AdditiveHash {
+    uint64_t operator()(std::string_view key) const {
+        uint64_t hash = 0;
+        for (char ch : key) {
+            ch = tolower(ch); // Normalize to lowercase
+            hash += (ch - 'a' + 1);
+        }
+        return hash;
+    }
+};
+
+// 64-bit wyhash (final version 4): multiply-mix of 8-byte words, very fast for short keys
+class WyHash {
+private:
+    static constexpr uint64_t secret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                           0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+    static void mum(uint64_t* a, uint64_t* b) {
+        __uint128_t r = (__uint128_t)*a * *b;
+        *a = (uint64_t)r;
+        *b = (uint64_t)(r >> 64);
+    }
+
+    static uint64_t mix(uint64_t a, uint64_t b) {
+        mum(&a, &b);
+        return a ^ b;
+    }
+
+    static uint64_t read8(const uint8_t* p) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        return v;
+    }
+
+    static uint64_t read4(const uint8_t* p) {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        return v;
+    }
+
+    static uint64_t read3(const uint8_t* p, size_t k) {
+        return ((uint64_t)p[0] << 16) | ((uint64_t)p[k >> 1] << 8) | p[k - 1];
+    }
+
+protected:
+    uint64_t seed;
+
+public:
+    WyHash(uint64_t seedValue = 0) : seed(seedValue) {}
+
+    static uint64_t hash(const void* key, size_t len, uint64_t state) {
+        const uint8_t* p = (const uint8_t*)key;
+        state ^= mix(state ^ secret[0], secret[1]);
+        uint64_t a, b;
+        if (len <= 16) {
+            if (len >= 4) {
+                a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+                b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+            } else if (len > 0) {
+                a = read3(p, len);
+                b = 0;
+            } else {
+                a = b = 0;
+            }
+        } else {
+            size_t i = len;
+            if (i > 48) {
+                uint64_t see1 = state, see2 = state;
+                do {
+                    state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+                    see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                    see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                state ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                state = mix(read8(p) ^ secret[1], read8(p + 8) ^ state);
+                i -= 16;
+                p += 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= state;
+        mum(&a, &b);
+        return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+
+    uint64_t operator()(std::string_view key) const {
+        return hash(key.data(), key.size(), seed);
+    }
+};
+
+// WyHash with a random per-instance seed. An attacker who does not know the seed
+// cannot precompute keys that collide, so collision floods do not work.
+class SeededWyHash : public WyHash {
+public:
+    SeededWyHash() : WyHash(randomSeed()) {}
+    explicit SeededWyHash(uint64_t seedValue) : WyHash(seedValue) {}
+
+    static uint64_t randomSeed() {
+        std::random_device device;
+        uint64_t value = ((uint64_t)device() << 32) ^ device();
+        return value ^ (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+};
@@ -1,89 +1,9 @@
 #include <iostream>
 #include <string>
+#include <string_view>
+#include "hash_table.h"
+#include "open_addressing_hash_table.h"
 using namespace std;
-struct Node {
-    string key;
-    Node* next;
-
-    Node(const string& keyValue) : key(keyValue), next(nullptr) {}
-};
-
-class HashTable {
-private:
-    Node** table; // Array of pointers to nodes
-    int size;
-
-    // Hash function
-    int hashFunction(const string& key) {
-        int hash = 0;
-        for (char ch : key) {
-            ch = tolower(ch); // Normalize to lowercase
-            hash += (ch - 'a' + 1);
-        }
-        return hash % size;
-    }
-
-public:
-    // Constructor
-    HashTable(int tableSize) : size(tableSize) {
-        table = new Node*[size];
-        for (int i = 0; i < size; i++) {
-            table[i] = nullptr; // Initialize buckets to nullptr
-        }
-    }
-
-    // Destructor
-    ~HashTable() {
-        for (int i = 0; i < size; i++) {
-            Node* current = table[i];
-            while (current) {
-                Node* toDelete = current;
-                current = current->next;
-                delete toDelete; // Delete nodes in the linked list
-            }
-        }
-        delete[] table; // Delete the table
-    }
-
-    // Insert a key
-    void insert(const string& key) {
-        int index = hashFunction(key);
-        Node* newNode = new Node(key);
-        if (!table[index]) {
-            table[index] = newNode; // Insert as the first node
-        } else {
-            // Collision: Add to the front of the linked list
-            newNode->next = table[index];
-            table[index] = newNode;
-        }
-    }
-
-    // Search for a key
-    bool search(const string& key) {
-        int index = hashFunction(key);
-        Node* current = table[index];
-        while (current) {
-            if (current->key == key) {
-                return true; // Key found
-            }
-            current = current->next;
-        }
-        return false; // Key not found
-    }
-
-    // Display the hash table
-    void display() {
-        for (int i = 0; i < size; i++) {
-            cout << i << ": ";
-            Node* current = table[i];
-            while (current) {
-                cout << current->key << " -> ";
-                current = current->next;
-            }
-            cout << "NULL\n";
-        }
-    }
-};
 
 int main() {
     HashTable hashTable(13);
@@ -97,9 +17,43 @@ int main() {
     // Display hash table
     hashTable.display();
 
+    // Membership filter in front of the chains: absent keys like "Basia" are usually
+    // rejected without walking a chain
+    hashTable.enableFilter();
+
     // Search for elements
     cout << "Czy 'Ola' istnieje? " << (hashTable.search("Ola") ? "Tak" : "Nie") << endl;
     cout << "Czy 'Basia' istnieje? " << (hashTable.search("Basia") ? "Tak" : "Nie") << endl;
 
+    // Load factor and chain lengths; lookup/collision counters need -DALGORYTMY_STATS=1
+    hashTable.stats().print(cout);
+
+    // Open addressing table with the same API, plus erase
+    FlatHashTable flatTable;
+    flatTable.insert("Antek");
+    flatTable.insert("Piotr");
+    flatTable.insert("Ola");
+    flatTable.insert("Kasia");
+    flatTable.erase("Piotr");
+
+    cout << "\nFlatHashTable:" << endl;
+    cout << "Czy 'Ola' istnieje? " << (flatTable.search("Ola") ? "Tak" : "Nie") << endl;
+    cout << "Czy 'Piotr' istnieje? " << (flatTable.search("Piotr") ? "Tak" : "Nie") << endl;
+
+    // Keys as slices of one buffer: string_view lookups need no temporary std::string,
+    // and KeyStorage::Borrow stores only views into the buffer (no key bytes copied)
+    string buffer = "Antek,Piotr,Ola,Kasia";
+    HashTable<> borrowedTable(13, 1.0, KeyStorage::Borrow);
+    string_view fields = buffer;
+    while (!fields.empty()) {
+        size_t comma = fields.find(',');
+        borrowedTable.insert(fields.substr(0, comma));
+        fields = comma == string_view::npos ? string_view() : fields.substr(comma + 1);
+    }
+
+    cout << "\nHashTable (KeyStorage::Borrow):" << endl;
+    cout << "Czy 'Kasia' istnieje? "
+         << (borrowedTable.search(string_view(buffer).substr(16)) ? "Tak" : "Nie") << endl;
+
     return 0;
 }
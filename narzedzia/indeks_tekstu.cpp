@@ -0,0 +1,65 @@
+// Build a suffix array index of a text file once, then query it (suffix_array.h).
+// Usage:
+//   ./indeks_tekstu build text.txt index.sa
+//   ./indeks_tekstu search index.sa pattern [pattern...]
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../wyszukaj_wzorzec/mapped_file.h"
+#include "../wyszukaj_wzorzec/suffix_array.h"
+using namespace std;
+
+static const size_t MAX_PRINTED = 20; // Further matches are only counted
+
+int build(const string& textPath, const string& indexPath) {
+    MappedFile file(textPath);
+    auto start = chrono::steady_clock::now();
+    SuffixArrayIndex index{string(file.view())};
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    index.save(indexPath);
+    cout << "Zbudowano indeks " << index.size() << " B tekstu w " << seconds << " s, zapisano do "
+         << indexPath << endl;
+    return 0;
+}
+
+int search(const string& indexPath, int patternCount, char* patterns[]) {
+    auto start = chrono::steady_clock::now();
+    SuffixArrayIndex index = SuffixArrayIndex::load(indexPath);
+    double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Wczytano " << indexPath << " (" << index.size() << " B tekstu) w " << loadMs << " ms"
+         << endl;
+    for (int i = 0; i < patternCount; i++) {
+        start = chrono::steady_clock::now();
+        vector<size_t> positions;
+        index.locate(patterns[i], [&](size_t position) { positions.push_back(position); });
+        double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        sort(positions.begin(), positions.end());
+        cout << "'" << patterns[i] << "': " << positions.size() << " wystapien (" << us << " us)";
+        for (size_t j = 0; j < positions.size() && j < MAX_PRINTED; j++) {
+            cout << " " << positions[j];
+        }
+        cout << (positions.size() > MAX_PRINTED ? " ..." : "") << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    try {
+        if (mode == "build" && argc == 4) {
+            return build(argv[2], argv[3]);
+        }
+        if (mode == "search" && argc >= 3) {
+            return search(argv[2], argc - 3, argv + 3);
+        }
+    } catch (const exception& error) {
+        cerr << error.what() << endl;
+        return 1;
+    }
+    cerr << "Uzycie: " << argv[0] << " build tekst.txt indeks.sa\n"
+         << "        " << argv[0] << " search indeks.sa wzorzec [wzorzec...]" << endl;
+    return 1;
+}
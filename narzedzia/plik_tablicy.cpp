@@ -0,0 +1,61 @@
+// Build and query MappedHashTable files (hash_table_file.h).
+// Usage:
+//   ./plik_tablicy build keys.txt table.htf      - keys one per line
+//   ./plik_tablicy search table.htf key [key...]
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../hash_table.h"
+#include "../hash_table_file.h"
+using namespace std;
+
+int build(const string& keysPath, const string& tablePath) {
+    ifstream input(keysPath);
+    if (!input) {
+        cerr << "Nie mozna otworzyc pliku: " << keysPath << endl;
+        return 1;
+    }
+    HashTable<WyHash> table(1024);
+    string line;
+    while (getline(input, line)) {
+        if (!table.search(line)) { // The file stores every key once
+            table.insert(line);
+        }
+    }
+    MappedHashTable::write(table, tablePath);
+    cout << "Zapisano " << table.keyCount() << " kluczy do " << tablePath << endl;
+    return 0;
+}
+
+int search(const string& tablePath, int keyCount, char* keys[]) {
+    auto start = chrono::steady_clock::now();
+    MappedHashTable table(tablePath);
+    double openUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    cout << "Otwarto " << tablePath << " (" << table.keyCount() << " kluczy) w " << openUs
+         << " us" << endl;
+    for (int i = 0; i < keyCount; i++) {
+        cout << "Czy '" << keys[i] << "' istnieje? " << (table.search(keys[i]) ? "Tak" : "Nie")
+             << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = argc > 1 ? argv[1] : "";
+    try {
+        if (mode == "build" && argc == 4) {
+            return build(argv[2], argv[3]);
+        }
+        if (mode == "search" && argc >= 3) {
+            return search(argv[2], argc - 3, argv + 3);
+        }
+    } catch (const runtime_error& error) {
+        cerr << error.what() << endl;
+        return 1;
+    }
+    cerr << "Uzycie: " << argv[0] << " build klucze.txt tablica.htf\n"
+         << "        " << argv[0] << " search tablica.htf klucz [klucz...]" << endl;
+    return 1;
+}
@@ -0,0 +1,71 @@
+// Search a file of any size for a pattern, reading it in fixed-size blocks (stream_search.h).
+// With -m the file is mmap'ed instead (mapped_file.h): no read() copies, pages of scanned
+// blocks are released as the search moves on.
+// Usage:
+//   ./szukaj_w_pliku [-m] <dfa|kmp|rk|naive> pattern file [block_bytes]
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "../wyszukaj_wzorzec/mapped_file.h"
+#include "../wyszukaj_wzorzec/stream_search.h"
+using namespace std;
+
+static const uint64_t MAX_PRINTED = 20; // Further matches are only counted
+
+template <typename Matcher>
+int scan(Matcher matcher, const string& path, size_t blockSize, bool mapped) {
+    uint64_t matches = 0;
+    auto onMatch = [&](uint64_t position) {
+        if (matches++ < MAX_PRINTED) {
+            cout << "Znaleziono wzorzec na pozycji " << position << "\n";
+        }
+    };
+    auto start = chrono::steady_clock::now();
+    uint64_t bytes;
+    if (mapped) {
+        MappedFile file(path);
+        scanMappedFile(file, matcher, onMatch, blockSize);
+        bytes = file.size();
+    } else {
+        bytes = scanFile(path, matcher, onMatch, blockSize);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Dopasowania: " << matches << ", przeczytano " << bytes << " B w " << seconds
+         << " s (" << bytes / seconds / 1e6 << " MB/s)" << endl;
+    if constexpr (STATS_ENABLED) {
+        searchStats().print(cerr);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    bool mapped = argc > 1 && string(argv[1]) == "-m";
+    char** args = argv + (mapped ? 1 : 0);
+    int argCount = argc - (mapped ? 1 : 0);
+    if (argCount < 4 || argCount > 5) {
+        cerr << "Uzycie: " << argv[0] << " [-m] <dfa|kmp|rk|naive> wzorzec plik [rozmiar_bloku]"
+             << endl;
+        return 1;
+    }
+    string mode = args[1];
+    string pattern = args[2];
+    string path = args[3];
+    size_t blockSize = argCount == 5 ? strtoull(args[4], nullptr, 10) : mapped ? 16 << 20 : 1 << 20;
+    if (blockSize == 0) {
+        cerr << "Rozmiar bloku musi byc dodatni" << endl;
+        return 1;
+    }
+    try {
+        if (mode == "dfa") return scan(StreamingDFA(pattern), path, blockSize, mapped);
+        if (mode == "kmp") return scan(StreamingKMP(pattern), path, blockSize, mapped);
+        if (mode == "rk") return scan(StreamingRabinKarp(pattern), path, blockSize, mapped);
+        if (mode == "naive") return scan(StreamingNaive(pattern), path, blockSize, mapped);
+    } catch (const runtime_error& error) {
+        cerr << error.what() << endl;
+        return 1;
+    }
+    cerr << "Nieznany algorytm: " << mode << endl;
+    return 1;
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "hashers.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Open addressing hash table in the style of SwissTable.
+// Every slot has one control byte: EMPTY, DELETED or a 7-bit fingerprint (H2) of the
+// key's hash. Keys live inline in one flat array (short names fit in the std::string
+// SSO buffer, so no extra allocation). A lookup scans 16 control bytes at a time and
+// compares strings only where the fingerprint matches.
+template <typename Hasher = WyHash>
+class FlatHashTable {
+private:
+    static const int8_t EMPTY = -128;  // 0b10000000
+    static const int8_t DELETED = -2;  // 0b11111110
+    static const size_t GROUP_WIDTH = 16;
+    static const size_t NOT_FOUND = (size_t)-1;
+
+    int8_t* ctrl;       // capacity + GROUP_WIDTH bytes, the tail mirrors the first group
+    std::string* slots; // capacity keys, valid only where ctrl[i] >= 0
+    size_t capacity;    // Power of two, at least GROUP_WIDTH
+    size_t count;       // Number of stored keys
+    size_t tombstones;  // Number of DELETED slots
+    Hasher hasher;
+
+    // Hash function
+    size_t hashFunction(std::string_view key) const {
+        return (size_t)hasher(key);
+    }
+
+    static size_t h1(size_t hash) { return hash >> 7; }
+    static int8_t h2(size_t hash) { return (int8_t)(hash & 0x7F); }
+
+    // Bit i is set when group[i] == value
+    static uint32_t matchByte(const int8_t* group, int8_t value) {
+#ifdef __SSE2__
+        __m128i g = _mm_loadu_si128((const __m128i*)group);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(value)));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; i++) {
+            if (group[i] == value) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Bit i is set when group[i] is EMPTY or DELETED (high bit set)
+    static uint32_t matchFree(const int8_t* group) {
+#ifdef __SSE2__
+        return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; i++) {
+            if (group[i] < 0) mask |= 1u << i;
+        }
+        return mask;
+#endif
+    }
+
+    void setCtrl(size_t index, int8_t value) {
+        ctrl[index] = value;
+        if (index < GROUP_WIDTH) {
+            ctrl[capacity + index] = value; // Keep the mirrored tail in sync
+        }
+    }
+
+    void allocate(size_t newCapacity) {
+        capacity = newCapacity;
+        ctrl = new int8_t[capacity + GROUP_WIDTH];
+        for (size_t i = 0; i < capacity + GROUP_WIDTH; i++) {
+            ctrl[i] = EMPTY;
+        }
+        slots = new std::string[capacity];
+        count = 0;
+        tombstones = 0;
+    }
+
+    size_t find(std::string_view key, size_t hash) const {
+        size_t mask = capacity - 1;
+        size_t pos = h1(hash) & mask;
+        int8_t fingerprint = h2(hash);
+        while (true) {
+            const int8_t* group = ctrl + pos;
+            uint32_t candidates = matchByte(group, fingerprint);
+            while (candidates) {
+                size_t index = (pos + __builtin_ctz(candidates)) & mask;
+                if (slots[index] == key) {
+                    return index;
+                }
+                candidates &= candidates - 1;
+            }
+            if (matchByte(group, EMPTY)) {
+                return NOT_FOUND; // The probe sequence ends at the first empty slot
+            }
+            pos = (pos + GROUP_WIDTH) & mask;
+        }
+    }
+
+    size_t findFreeSlot(size_t hash) const {
+        size_t mask = capacity - 1;
+        size_t pos = h1(hash) & mask;
+        while (true) {
+            uint32_t free = matchFree(ctrl + pos);
+            if (free) {
+                return (pos + __builtin_ctz(free)) & mask;
+            }
+            pos = (pos + GROUP_WIDTH) & mask;
+        }
+    }
+
+    // Move every key into fresh arrays (also drops all tombstones)
+    void rehash(size_t newCapacity) {
+        int8_t* oldCtrl = ctrl;
+        std::string* oldSlots = slots;
+        size_t oldCapacity = capacity;
+
+        allocate(newCapacity);
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] >= 0) {
+                size_t hash = hashFunction(oldSlots[i]);
+                size_t index = findFreeSlot(hash);
+                setCtrl(index, h2(hash));
+                slots[index] = std::move(oldSlots[i]);
+                count++;
+            }
+        }
+        delete[] oldCtrl;
+        delete[] oldSlots;
+    }
+
+public:
+    // Constructor
+    FlatHashTable(int tableSize = GROUP_WIDTH) {
+        size_t newCapacity = GROUP_WIDTH;
+        while (newCapacity < (size_t)tableSize) {
+            newCapacity *= 2;
+        }
+        allocate(newCapacity);
+    }
+
+    FlatHashTable(const FlatHashTable&) = delete;
+    FlatHashTable& operator=(const FlatHashTable&) = delete;
+
+    // Destructor
+    ~FlatHashTable() {
+        delete[] ctrl;
+        delete[] slots;
+    }
+
+    // Insert a key (duplicates are ignored)
+    void insert(std::string_view key) {
+        size_t hash = hashFunction(key);
+        if (find(key, hash) != NOT_FOUND) {
+            return;
+        }
+        // Keep at least 1/8 of the slots EMPTY so every probe sequence terminates
+        if ((count + tombstones + 1) * 8 > capacity * 7) {
+            rehash((count + 1) * 16 > capacity * 7 ? capacity * 2 : capacity);
+        }
+        size_t index = findFreeSlot(hash);
+        if (ctrl[index] == DELETED) {
+            tombstones--;
+        }
+        setCtrl(index, h2(hash));
+        slots[index] = key;
+        count++;
+    }
+
+    // Search for a key
+    bool search(std::string_view key) const {
+        return find(key, hashFunction(key)) != NOT_FOUND;
+    }
+
+    // Erase a key, returns false when the key was not present
+    bool erase(std::string_view key) {
+        size_t index = find(key, hashFunction(key));
+        if (index == NOT_FOUND) {
+            return false;
+        }
+        setCtrl(index, DELETED); // Tombstone, so probe sequences passing here stay intact
+        std::string().swap(slots[index]);
+        count--;
+        tombstones++;
+        return true;
+    }
+
+    size_t size() const { return count; }
+
+    // Display the hash table
+    void display() const {
+        for (size_t i = 0; i < capacity; i++) {
+            std::cout << i << ": ";
+            if (ctrl[i] == EMPTY) {
+                std::cout << "EMPTY\n";
+            } else if (ctrl[i] == DELETED) {
+                std::cout << "DELETED\n";
+            } else {
+                std::cout << slots[i] << "\n";
+            }
+        }
+    }
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "hashers.h"
+
+// Static hash set built once from the full key set with a minimal perfect hash function
+// (PTHash-style "hash and displace"), for dictionaries that are only read after loading.
+//
+// Keys are split into ~n/KEYS_PER_BUCKET buckets. Buckets are processed from the largest
+// and every bucket gets the smallest 16-bit pilot p for which
+//     position(key) = reduce(mix(hash(key) ^ mix(p)), m)
+// is free for all of its keys. m = n / LOAD_FACTOR is a bit larger than n, which makes
+// the search fast; positions >= n are remapped to the slots < n that stayed free, so the
+// final function is minimal: n keys -> n slots, each search is exactly one probe.
+// The function itself costs ~4 bits of pilot per key plus a small remap table; the keys
+// are stored back to back with one 32-bit offset each (no next pointers, no empty slots).
+class PerfectHashTable {
+private:
+    static constexpr double KEYS_PER_BUCKET = 4.0;
+    static constexpr double LOAD_FACTOR = 0.98;
+    static const uint32_t MAX_PILOT = 65535;
+    static const int MAX_ATTEMPTS = 16; // Seeds to try before giving up
+
+    uint64_t seed;
+    uint64_t keyCount;    // n
+    uint64_t slotCount;   // m >= n, range of position()
+    uint64_t bucketCount;
+    std::vector<uint16_t> pilots;  // One per bucket
+    std::vector<uint32_t> remap;   // remap[p - n] for positions p >= n
+    std::vector<uint32_t> offsets; // Key of slot i is strings[offsets[i], offsets[i + 1])
+    std::string strings;
+
+    static uint64_t mix(uint64_t x) { // splitmix64 finalizer
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t hashKey(std::string_view key) const {
+        return WyHash::hash(key.data(), key.size(), seed);
+    }
+    // x * range / 2^64 - maps x into [0, range) without a division
+    static uint64_t reduce(uint64_t x, uint64_t range) {
+        return (uint64_t)(((__uint128_t)x * range) >> 64);
+    }
+
+    uint64_t bucketOf(uint64_t hash) const { return reduce(hash, bucketCount); }
+    static uint64_t position(uint64_t hash, uint32_t pilot, uint64_t slots) {
+        return reduce(mix(hash ^ mix(pilot + 1)), slots);
+    }
+
+    uint64_t slotOf(uint64_t hash) const {
+        uint64_t p = position(hash, pilots[bucketOf(hash)], slotCount);
+        return p < keyCount ? p : remap[p - keyCount];
+    }
+
+    // One attempt with the current seed; false when some bucket found no pilot
+    bool tryBuild(const std::vector<std::string_view>& keys) {
+        std::vector<uint64_t> hashes(keys.size());
+        std::vector<uint32_t> order(keys.size()); // Key indices grouped by bucket
+        std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+        for (size_t i = 0; i < keys.size(); i++) {
+            hashes[i] = hashKey(keys[i]);
+            bucketStart[bucketOf(hashes[i]) + 1]++;
+        }
+        for (uint64_t b = 0; b < bucketCount; b++) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        std::vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < keys.size(); i++) {
+            order[fill[bucketOf(hashes[i])]++] = (uint32_t)i;
+        }
+
+        std::vector<uint32_t> buckets(bucketCount);
+        for (uint64_t b = 0; b < bucketCount; b++) {
+            buckets[b] = (uint32_t)b;
+        }
+        std::stable_sort(buckets.begin(), buckets.end(), [&](uint32_t a, uint32_t b) {
+            return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+
+        std::vector<bool> taken(slotCount, false);
+        std::vector<uint64_t> positions;
+        pilots.assign(bucketCount, 0);
+        for (uint32_t b : buckets) {
+            uint32_t begin = bucketStart[b], end = bucketStart[b + 1];
+            if (begin == end) {
+                break; // Sorted by size, the rest is empty too
+            }
+            bool placed = false;
+            for (uint32_t pilot = 0; pilot <= MAX_PILOT && !placed; pilot++) {
+                positions.clear();
+                placed = true;
+                for (uint32_t k = begin; k < end && placed; k++) {
+                    uint64_t p = position(hashes[order[k]], pilot, slotCount);
+                    if (taken[p] || std::find(positions.begin(), positions.end(), p) != positions.end()) {
+                        placed = false;
+                    }
+                    positions.push_back(p);
+                }
+                if (placed) {
+                    pilots[b] = (uint16_t)pilot;
+                    for (uint64_t p : positions) {
+                        taken[p] = true;
+                    }
+                }
+            }
+            if (!placed) {
+                return false;
+            }
+        }
+
+        // Positions >= n are taken exactly as often as slots < n are left free
+        remap.assign(slotCount - keyCount, 0);
+        uint64_t freeSlot = 0;
+        for (uint64_t p = keyCount; p < slotCount; p++) {
+            if (taken[p]) {
+                while (taken[freeSlot]) {
+                    freeSlot++;
+                }
+                remap[p - keyCount] = (uint32_t)freeSlot++;
+            }
+        }
+
+        // Store the keys in slot order
+        std::vector<uint32_t> keyOfSlot(keyCount);
+        for (size_t i = 0; i < keys.size(); i++) {
+            keyOfSlot[slotOf(hashes[i])] = (uint32_t)i;
+        }
+        offsets.assign(keyCount + 1, 0);
+        strings.clear();
+        for (uint64_t slot = 0; slot < keyCount; slot++) {
+            offsets[slot] = (uint32_t)strings.size();
+            strings.append(keys[keyOfSlot[slot]]);
+        }
+        offsets[keyCount] = (uint32_t)strings.size();
+        return true;
+    }
+
+public:
+    // Build from any range of keys convertible to std::string_view (duplicates are removed)
+    template <typename KeyRange>
+    explicit PerfectHashTable(const KeyRange& keyRange) : seed(0) {
+        std::vector<std::string_view> keys;
+        size_t totalBytes = 0;
+        for (const auto& key : keyRange) {
+            keys.push_back(std::string_view(key));
+            totalBytes += keys.back().size();
+        }
+        if (totalBytes > UINT32_MAX || keys.size() > UINT32_MAX) {
+            throw std::runtime_error("PerfectHashTable: key set too large");
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        keyCount = keys.size();
+        slotCount = std::max<uint64_t>(keyCount, (uint64_t)(keyCount / LOAD_FACTOR) + 1);
+        bucketCount = std::max<uint64_t>(1, (uint64_t)(keyCount / KEYS_PER_BUCKET) + 1);
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+            seed = SeededWyHash::randomSeed();
+            if (tryBuild(keys)) {
+                return;
+            }
+        }
+        throw std::runtime_error("PerfectHashTable: no perfect hash function found");
+    }
+
+    // Search for a key: one slot, at most one key comparison
+    bool search(std::string_view key) const {
+        if (keyCount == 0) {
+            return false;
+        }
+        uint64_t slot = slotOf(hashKey(key));
+        uint32_t begin = offsets[slot];
+        return offsets[slot + 1] - begin == key.size() &&
+               memcmp(strings.data() + begin, key.data(), key.size()) == 0;
+    }
+
+    size_t size() const { return keyCount; }
+
+    // Bits per key of the hash function itself (pilots + remap table)
+    double functionBitsPerKey() const {
+        if (keyCount == 0) {
+            return 0;
+        }
+        size_t bytes = pilots.size() * sizeof(uint16_t) + remap.size() * sizeof(uint32_t);
+        return 8.0 * bytes / keyCount;
+    }
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Hot-path instrumentation. Counters are compiled in only with -DALGORYTMY_STATS=1
+// (CMake: -DALGORYTMY_STATS=ON); otherwise every update is an `if constexpr` on a false
+// constant and the instrumented loops compile to exactly the same code as before.
+#ifndef ALGORYTMY_STATS
+#define ALGORYTMY_STATS 0
+#endif
+
+inline constexpr bool STATS_ENABLED = ALGORYTMY_STATS != 0;
+
+// Histogram with power-of-two buckets: bucket 0 holds value 0, bucket b holds
+// [2^(b-1), 2^b), and the last bucket everything above
+template <size_t Buckets = 16>
+struct Histogram {
+    uint64_t counts[Buckets] = {};
+
+    static size_t bucketOf(uint64_t value) {
+        size_t bucket = value == 0 ? 0 : 64 - __builtin_clzll(value);
+        return std::min(bucket, Buckets - 1);
+    }
+
+    static uint64_t bucketLow(size_t bucket) { return bucket == 0 ? 0 : 1ull << (bucket - 1); }
+
+    void record(uint64_t value, uint64_t times = 1) { counts[bucketOf(value)] += times; }
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for (uint64_t c : counts) sum += c;
+        return sum;
+    }
+
+    // One line: "lo..hi:count" for every non-empty bucket
+    void print(std::ostream& out) const {
+        for (size_t b = 0; b < Buckets; b++) {
+            if (!counts[b]) continue;
+            out << " " << bucketLow(b);
+            if (b + 1 == Buckets) {
+                out << "+";
+            } else if (b > 1) {
+                out << ".." << bucketLow(b + 1) - 1;
+            }
+            out << ":" << counts[b];
+        }
+    }
+};
+
+// Exact counts of small values: slot v counts value v for every v < Limit, the last slot
+// counts everything from Limit up
+template <size_t Limit = 64>
+struct CappedCounts {
+    static constexpr size_t Slots = Limit + 1;
+    uint64_t counts[Slots] = {};
+
+    void record(uint64_t value, uint64_t times = 1) {
+        counts[std::min<uint64_t>(value, Limit)] += times;
+    }
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for (uint64_t c : counts) sum += c;
+        return sum;
+    }
+
+    // One line: "value:count" for every non-zero slot, "Limit+:count" for the last one
+    void print(std::ostream& out) const {
+        for (size_t v = 0; v < Slots; v++) {
+            if (!counts[v]) continue;
+            out << " " << v << (v == Limit ? "+" : "") << ":" << counts[v];
+        }
+    }
+};
+
+// Shared counts updated from many threads - hot loops fill a local Histogram (or
+// CappedCounts) and merge it once per call, so the atomics are off the per-byte path
+template <typename Local>
+struct AtomicCounts {
+    static constexpr size_t Slots = sizeof(Local::counts) / sizeof(Local::counts[0]);
+    std::atomic<uint64_t> counts[Slots] = {};
+
+    void merge(const Local& local) {
+        for (size_t b = 0; b < Slots; b++) {
+            if (local.counts[b]) counts[b].fetch_add(local.counts[b], std::memory_order_relaxed);
+        }
+    }
+
+    Local snapshot() const {
+        Local copy;
+        for (size_t b = 0; b < Slots; b++) {
+            copy.counts[b] = counts[b].load(std::memory_order_relaxed);
+        }
+        return copy;
+    }
+
+    void reset() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+    }
+};
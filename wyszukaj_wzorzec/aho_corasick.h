@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @brief Automat Aho-Corasick - wyszukiwanie wielu wzorców w jednym liniowym przejściu.
+ *
+ * Automat to drzewo trie wszystkich wzorców z dodanymi krawędziami "porażki" (fail).
+ * Krawędź fail stanu u prowadzi do najdłuższego właściwego sufiksu słowa u, który jest
+ * prefiksem któregoś wzorca - to dokładnie uogólnienie tablicy LPS z algorytmu KMP
+ * (Algorytm KPM/main_KPM.cpp) z jednego wzorca na całe drzewo. Liczymy ją tak samo jak
+ * w computeLPSArray: przy niedopasowaniu cofamy się `length = lps[length - 1]`, tu
+ * `state = fail[state]`, aż znajdziemy przejście albo dojdziemy do korzenia.
+ *
+ * Układ pamięci:
+ * - stany numerowane są wszerz (BFS), więc płytkie stany - odwiedzane najczęściej - mają
+ *   najmniejsze numery, a krawędź fail zawsze prowadzi do stanu o mniejszym numerze,
+ * - "gorące" stany (korzeń i kilka pierwszych poziomów) mają pełne wiersze 256 przejść
+ *   z już rozwiązanymi krawędziami fail, jak tablica dfa w automat.cpp - jeden odczyt na znak,
+ * - pozostałe stany trzymają tylko własne krawędzie, posortowane, w jednej ciągłej
+ *   tablicy (CSR), plus krawędź fail - pamięć rośnie liniowo z sumą długości wzorców.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Automat Aho-Corasick dla stałego zbioru wzorców.
+ */
+class AhoCorasick {
+private:
+    static constexpr uint32_t NONE = ~0u;
+    static constexpr int ALPHABET_SIZE = 256;
+    static constexpr uint32_t MAX_DENSE_STATES = 1024; ///< Co najwyżej 1 MB pełnych wierszy
+    static constexpr uint32_t MAX_DENSE_DEPTH = 3;     ///< Pełne wiersze tylko do tej głębokości
+
+    std::vector<std::string> patterns;
+    std::vector<uint32_t> nextSamePattern; ///< Powtórzone wzorce kończą się w tym samym stanie
+
+    uint32_t denseStates = 0;              ///< Stany [0, denseStates) mają pełne wiersze
+    std::vector<uint32_t> dense;           ///< dense[state * 256 + c] - następny stan
+    std::vector<uint32_t> edgeStart;       ///< Krawędzie stanu s: [edgeStart[s], edgeStart[s + 1])
+    std::vector<unsigned char> edgeLabel;  ///< Posortowane rosnąco w obrębie stanu
+    std::vector<uint32_t> edgeTarget;
+    std::vector<uint32_t> fail;
+    std::vector<uint32_t> patternAt;       ///< Wzorzec kończący się w stanie (lub NONE)
+    std::vector<uint32_t> outputLink;      ///< Najbliższy stan na ścieżce fail z wzorcem
+
+    /**
+     * @brief Krawędź drzewa trie (bez krawędzi fail) - wyszukiwanie binarne w CSR.
+     */
+    uint32_t child(uint32_t state, unsigned char c) const {
+        uint32_t low = edgeStart[state], high = edgeStart[state + 1];
+        while (low < high) {
+            uint32_t mid = (low + high) / 2;
+            if (edgeLabel[mid] < c) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low < edgeStart[state + 1] && edgeLabel[low] == c ? edgeTarget[low] : NONE;
+    }
+
+    /**
+     * @brief Przejście automatu: krawędź trie albo, przy jej braku, cofanie po krawędziach fail.
+     */
+    uint32_t step(uint32_t state, unsigned char c) const {
+        while (state >= denseStates) {
+            uint32_t next = child(state, c);
+            if (next != NONE) {
+                return next;
+            }
+            state = fail[state];
+        }
+        return dense[(size_t)state * ALPHABET_SIZE + c];
+    }
+
+public:
+    /**
+     * @brief Buduje automat dla podanych wzorców (puste wzorce są pomijane).
+     */
+    explicit AhoCorasick(const std::vector<std::string>& patternList)
+        : patterns(patternList), nextSamePattern(patternList.size(), NONE) {
+        // 1. Drzewo trie (tymczasowo z krawędziami jako listami)
+        std::vector<std::vector<std::pair<unsigned char, uint32_t>>> trie(1);
+        std::vector<uint32_t> trieEnd(1, NONE);
+        for (uint32_t id = 0; id < patterns.size(); id++) {
+            if (patterns[id].empty()) {
+                continue;
+            }
+            uint32_t state = 0;
+            for (char ch : patterns[id]) {
+                unsigned char c = (unsigned char)ch;
+                uint32_t next = NONE;
+                for (auto& edge : trie[state]) {
+                    if (edge.first == c) {
+                        next = edge.second;
+                        break;
+                    }
+                }
+                if (next == NONE) {
+                    next = (uint32_t)trie.size();
+                    trie[state].push_back({c, next});
+                    trie.emplace_back();
+                    trieEnd.push_back(NONE);
+                }
+                state = next;
+            }
+            nextSamePattern[id] = trieEnd[state];
+            trieEnd[state] = id;
+        }
+
+        // 2. Numeracja wszerz i układ CSR z posortowanymi krawędziami
+        std::vector<uint32_t> order; // order[nowy numer] = stary numer
+        std::vector<uint32_t> depth(trie.size(), 0);
+        std::vector<uint32_t> renumber(trie.size());
+        order.push_back(0);
+        for (size_t k = 0; k < order.size(); k++) {
+            auto& edges = trie[order[k]];
+            std::sort(edges.begin(), edges.end());
+            for (auto& edge : edges) {
+                depth[edge.second] = depth[order[k]] + 1;
+                order.push_back(edge.second);
+            }
+        }
+        size_t stateCount = order.size();
+        for (uint32_t s = 0; s < stateCount; s++) {
+            renumber[order[s]] = s;
+        }
+        edgeStart.assign(stateCount + 1, 0);
+        patternAt.assign(stateCount, NONE);
+        for (uint32_t s = 0; s < stateCount; s++) {
+            edgeStart[s + 1] = edgeStart[s] + (uint32_t)trie[order[s]].size();
+            patternAt[s] = trieEnd[order[s]];
+            for (auto& edge : trie[order[s]]) {
+                edgeLabel.push_back(edge.first);
+                edgeTarget.push_back(renumber[edge.second]);
+            }
+        }
+        while (denseStates < stateCount && denseStates < MAX_DENSE_STATES &&
+               depth[order[denseStates]] <= MAX_DENSE_DEPTH) {
+            denseStates++;
+        }
+
+        // 3. Krawędzie fail (jak tablica LPS) i łącza wyjścia, w kolejności BFS:
+        //    stan rodzica i jego krawędź fail są już gotowe, gdy dochodzimy do dziecka
+        fail.assign(stateCount, 0);
+        outputLink.assign(stateCount, NONE);
+        dense.assign((size_t)denseStates * ALPHABET_SIZE, 0);
+        for (uint32_t s = 0; s < stateCount; s++) {
+            for (uint32_t e = edgeStart[s]; e < edgeStart[s + 1]; e++) {
+                uint32_t target = edgeTarget[e];
+                unsigned char c = edgeLabel[e];
+                if (s != 0) {
+                    uint32_t length = fail[s]; // Jak `length = lps[length - 1]` w KMP
+                    uint32_t next = child(length, c);
+                    while (next == NONE && length != 0) {
+                        length = fail[length];
+                        next = child(length, c);
+                    }
+                    fail[target] = next == NONE ? 0 : next;
+                }
+                uint32_t f = fail[target];
+                outputLink[target] = patternAt[f] != NONE ? f : outputLink[f];
+            }
+            if (s < denseStates) {
+                // Pełny wiersz: krawędzie fail rozwiązane z góry, jak w buildDFA
+                uint32_t* row = &dense[(size_t)s * ALPHABET_SIZE];
+                if (s != 0) {
+                    const uint32_t* fallback = &dense[(size_t)fail[s] * ALPHABET_SIZE];
+                    for (int c = 0; c < ALPHABET_SIZE; c++) {
+                        row[c] = fallback[c];
+                    }
+                }
+                for (uint32_t e = edgeStart[s]; e < edgeStart[s + 1]; e++) {
+                    row[edgeLabel[e]] = edgeTarget[e];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Przeszukuje tekst jednym przejściem, raportując wszystkie dopasowania
+     *        wszystkich wzorców (także nachodzące na siebie i zagnieżdżone).
+     *
+     * @param text     Tekst, w którym szukamy
+     * @param onMatch  Wywoływane jako onMatch(pozycja, indeks wzorca) - w kolejności
+     *                 rosnącej pozycji końca dopasowania
+     *
+     * @note Złożoność O(n + liczba dopasowań), niezależnie od liczby wzorców.
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        uint32_t state = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            state = step(state, (unsigned char)text[i]);
+            uint32_t out = patternAt[state] != NONE ? state : outputLink[state];
+            while (out != NONE) {
+                for (uint32_t id = patternAt[out]; id != NONE; id = nextSamePattern[id]) {
+                    onMatch(i + 1 - patterns[id].size(), (size_t)id);
+                }
+                out = outputLink[out];
+            }
+        }
+    }
+
+    const std::string& pattern(size_t id) const { return patterns[id]; }
+
+    size_t stateCount() const { return fail.size(); }
+
+    /**
+     * @brief Pamięć zajmowana przez automat (bez samych wzorców), w bajtach.
+     */
+    size_t memoryBytes() const {
+        return dense.size() * sizeof(uint32_t) + edgeStart.size() * sizeof(uint32_t) +
+               edgeLabel.size() + edgeTarget.size() * sizeof(uint32_t) +
+               (fail.size() + patternAt.size() + outputLink.size()) * sizeof(uint32_t);
+    }
+};
@@ -0,0 +1,141 @@
+/**
+ * @file
+ * @brief Automatyczny wybór algorytmu wyszukiwania na podstawie wzorca.
+ *
+ * \ref chooseEngine patrzy na długość wzorca, liczbę różnych bajtów we wzorcu, tryb
+ * wielkości liter i dostępny wariant SIMD. Reguły wynikają z pomiarów
+ * (benchmarki/skip_search_benchmark.cpp):
+ * - zwykle wygrywa naiwny SIMD (simd_search.h). Filtr pierwszego i ostatniego znaku
+ *   odrzuca prawie wszystkie pozycje, a sam odczyt tekstu jest ograniczony
+ *   przepustowością pamięci - Horspool, mimo że czyta mniej bajtów, trafia w nową linię
+ *   pamięci podręcznej przy każdym przeskoku i nie jest szybszy,
+ * - wzorzec z najwyżej dwoma różnymi bajtami (np. "aaaa...ab", dane binarne) - filtr SIMD
+ *   przepuszcza wtedy bardzo wiele pozycji, a naiwny i Horspool w najgorszym przypadku
+ *   zwalniają do O(n*m). Wybieramy metodę liniową: CompiledKMP (automat, jeśli mieści się
+ *   w L1), a dla bardzo długich wzorców Two-Way, który nie potrzebuje żadnej tablicy,
+ * - bez SIMD (inne architektury) długi wzorzec z dużym alfabetem przeszukuje Horspool,
+ * - bez rozróżniania wielkości liter: naiwny SIMD lub zwarty automat (compact_dfa.h).
+ *
+ * W praktyce, gdy dostępny jest SIMD, Horspool nie jest wybierany nigdy, a Two-Way tylko
+ * dla wzorców z najwyżej dwoma różnymi bajtami dłuższych niż około 5-8 tys. znaków (5460
+ * dla dwóch bajtów, 8191 dla jednego) - dopiero wtedy automat CompiledKMP przekracza 32 KB.
+ *
+ * Rabin-Karp nie jest wybierany - dla jednego wzorca jest wolniejszy od wszystkich
+ * powyższych; ma sens dla wielu wzorców (\ref MultiPatternRabinKarp).
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include "../Algorytm KPM/compiled_kmp.h"
+#include "automat_wyszukiwanie_wzorca/compact_dfa.h"
+#include "simd_search.h"
+#include "skip_search.h"
+
+/**
+ * @brief Algorytmy, spośród których wybiera \ref chooseEngine.
+ */
+enum class SearchEngine { SimdNaive, Horspool, TwoWay, KMP, DFA };
+
+inline const char* engineName(SearchEngine engine) {
+    switch (engine) {
+    case SearchEngine::SimdNaive:
+        return "naiwny SIMD";
+    case SearchEngine::Horspool:
+        return "Horspool";
+    case SearchEngine::TwoWay:
+        return "Two-Way";
+    case SearchEngine::KMP:
+        return "KMP";
+    case SearchEngine::DFA:
+        return "automat DFA";
+    }
+    return "?";
+}
+
+/**
+ * @brief Wybiera algorytm dla wzorca (zob. opis pliku).
+ */
+inline SearchEngine chooseEngine(std::string_view pattern, CaseMode mode = CaseMode::Sensitive,
+                                 SimdLevel level = detectSimdLevel()) {
+    static constexpr size_t MIN_DEGENERATE_LENGTH = 16; ///< Krótszym wzorcom naiwny nie szkodzi
+    static constexpr size_t MIN_SKIP_LENGTH = 8;        ///< Od tej długości Horspool przeskakuje
+    static constexpr size_t MIN_SKIP_ALPHABET = 8;
+
+    bool used[256] = {false};
+    size_t distinct = 0;
+    for (char ch : pattern) {
+        unsigned char c = (unsigned char)(mode == CaseMode::Insensitive ? foldCase(ch) : ch);
+        if (!used[c]) {
+            used[c] = true;
+            distinct++;
+        }
+    }
+    bool degenerate = pattern.size() >= MIN_DEGENERATE_LENGTH && distinct <= 2;
+
+    if (mode == CaseMode::Insensitive) {
+        return degenerate ? SearchEngine::DFA : SearchEngine::SimdNaive;
+    }
+    if (degenerate) {
+        return CompiledKMP::autoUsesDFA(pattern) ? SearchEngine::KMP : SearchEngine::TwoWay;
+    }
+    if (level == SimdLevel::Scalar && pattern.size() >= MIN_SKIP_LENGTH &&
+        distinct >= MIN_SKIP_ALPHABET) {
+        return SearchEngine::Horspool;
+    }
+    return SearchEngine::SimdNaive;
+}
+
+/**
+ * @brief Wzorzec przygotowany dla algorytmu wybranego przez \ref chooseEngine.
+ */
+class AutoMatcher {
+private:
+    std::string pattern;
+    CaseMode mode;
+    SearchEngine chosen;
+    std::variant<std::monostate, HorspoolMatcher, TwoWayMatcher, CompiledKMP, CompactDFA> engine;
+
+public:
+    explicit AutoMatcher(std::string_view patternText, CaseMode caseMode = CaseMode::Sensitive)
+        : pattern(patternText), mode(caseMode), chosen(chooseEngine(patternText, caseMode)) {
+        switch (chosen) {
+        case SearchEngine::SimdNaive:
+            break; // Naiwny nie potrzebuje przygotowania
+        case SearchEngine::Horspool:
+            engine.emplace<HorspoolMatcher>(pattern);
+            break;
+        case SearchEngine::TwoWay:
+            engine.emplace<TwoWayMatcher>(pattern);
+            break;
+        case SearchEngine::KMP:
+            engine.emplace<CompiledKMP>(pattern);
+            break;
+        case SearchEngine::DFA:
+            engine.emplace<CompactDFA>(pattern, mode);
+            break;
+        }
+    }
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca, w kolejności rosnącej.
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        if (pattern.empty()) {
+            return;
+        }
+        std::visit([&](const auto& matcher) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(matcher)>, std::monostate>) {
+                simdSearch(text, pattern, onMatch, mode);
+            } else {
+                matcher.search(text, onMatch);
+            }
+        }, engine);
+    }
+
+    SearchEngine engineUsed() const { return chosen; }
+};
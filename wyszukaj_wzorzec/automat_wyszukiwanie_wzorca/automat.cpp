@@ -1,28 +1,14 @@
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include "compact_dfa.h"
+#include "../mapped_file.h"
+#include "../match_sinks.h"
+#include "../stream_search.h"
 
 using namespace std;
 
-/**
- * @brief Funkcja toLowerCase
- * 
- * Zwraca nowy łańcuch znaków, w którym wszystkie litery z przedziału 'A'..'Z' 
- * zostały przekształcone w odpowiadające im małe litery z przedziału 'a'..'z'.
- * 
- * @param s Oryginalny łańcuch wejściowy
- * @return Nowy łańcuch, w którym wszystkie wielkie litery zamieniono na małe
- */
-string toLowerCase(const string& s) {
-    string result = s; // Kopiujemy oryginalny łańcuch
-    for (int i = 0; i < (int)result.size(); i++) {
-        // Jeśli znak jest w przedziale 'A'..'Z', to zamieniamy na 'a'..'z'
-        if (result[i] >= 'A' && result[i] <= 'Z') {
-            result[i] = result[i] - 'A' + 'a';
-        }
-    }
-    return result;
-}
-
 /**
  * @brief Funkcja buildDFA
  * 
@@ -76,77 +62,146 @@ int** buildDFA(const string& pattern) {
  * @brief Funkcja searchWithDFA
  * 
  * Wyszukuje wystąpienia zadanego wzorca w danym tekście przy pomocy uprzednio
- * zbudowanego automatu (DFA).
+ * zbudowanego automatu (DFA). Niczego nie wypisuje - pozycje przekazuje do onMatch.
  * 
  * @param text Tekst (łańcuch znaków), w którym dokonujemy wyszukiwania
  * @param pattern Wzorzec (łańcuch znaków), którego szukamy
  * @param dfa Wskaźnik na tablicę przejść automatu zbudowaną przez buildDFA()
+ * @param onMatch Wywoływane z pozycją każdego wystąpienia (np. \ref collectInto
+ *                z match_sinks.h)
  * @return Liczba znalezionych wystąpień wzorca w tekście
  * 
  * @note Zależnie od tego, czy pattern i text są znormalizowane (np. do małych liter),
  *       wyszukiwanie może być wrażliwe lub niewrażliwe na wielkość liter.
  */
-int searchWithDFA(const string& text, const string& pattern, int** dfa) {
+template <typename OnMatch>
+int searchWithDFA(const string& text, const string& pattern, int** dfa, OnMatch onMatch) {
     int m = pattern.size();
     int n = text.size();
 
     int occurrences = 0;  // licznik wystąpień
     int state = 0;        // stan automatu
+    DFAProbe probe;       // Liczniki tylko z ALGORYTMY_STATS (zob. search_stats.h)
 
     for (int i = 0; i < n; i++) {
         // Przechodzimy do kolejnego stanu na podstawie znaku text[i]
         state = dfa[state][(unsigned char)text[i]];
+        probe.visit(state);
 
         // Jeśli osiągnęliśmy stan m, to znaczy, że wzorzec został dopasowany
         if (state == m) {
             occurrences++;
-            cout << "Znaleziono wystapienie wzorca na pozycji: " 
-                 << (i - m + 1) << endl;
+            probe.match();
+            onMatch((size_t)(i - m + 1));
         }
     }
     return occurrences;
 }
 
+/**
+ * @brief Funkcja searchWithDFA (wersja wypisująca)
+ * 
+ * Jak wyżej, ale każde wystąpienie jest wypisywane na ekran.
+ */
+int searchWithDFA(const string& text, const string& pattern, int** dfa) {
+    return searchWithDFA(text, pattern, dfa, [](size_t position) {
+        cout << "Znaleziono wystapienie wzorca na pozycji: " << position << "\n";
+    });
+}
+
+/**
+ * @brief Funkcja searchWithCompactDFA
+ * 
+ * Działa jak połączenie buildDFA() i searchWithDFA(), ale używa zwartej tablicy
+ * przejść (zob. \ref CompactDFA w compact_dfa.h): jedna ciągła alokacja, numery stanów
+ * typu uint8_t/uint16_t dobrane do długości wzorca i kolumny tylko dla klas bajtów,
+ * które występują we wzorcu. Dla typowych wzorców cała tablica mieści się w L1,
+ * więc pętla wyszukiwania nie czeka na pamięć.
+ * 
+ * @param text Tekst (łańcuch znaków), w którym dokonujemy wyszukiwania
+ * @param pattern Wzorzec (łańcuch znaków), którego szukamy
+ * @param onMatch Wywoływane z pozycją każdego wystąpienia
+ * @param mode Czy rozróżniać wielkość liter (bez rozróżniania obie wielkości litery
+ *             należą do tej samej klasy bajtów, więc tekst nie jest kopiowany)
+ * @return Liczba znalezionych wystąpień wzorca w tekście
+ */
+template <typename OnMatch>
+int searchWithCompactDFA(string_view text, const string& pattern, OnMatch onMatch,
+                         CaseMode mode = CaseMode::Sensitive) {
+    CompactDFA dfa(pattern, mode);
+    int occurrences = 0;
+    dfa.search(text, [&](size_t position) {
+        occurrences++;
+        onMatch(position);
+    });
+    return occurrences;
+}
+
+/**
+ * @brief Funkcja searchWithCompactDFA (wersja wypisująca)
+ */
+int searchWithCompactDFA(string_view text, const string& pattern,
+                         CaseMode mode = CaseMode::Sensitive) {
+    return searchWithCompactDFA(text, pattern, [](size_t position) {
+        cout << "Znaleziono wystapienie wzorca na pozycji: " << position << "\n";
+    }, mode);
+}
+
 /**
  * @brief Funkcja searchCaseInsensitive
  * 
  * Wykonuje wyszukiwanie wzorca w tekście niewrażliwe na wielkość liter.
- * 1. Konwertuje tekst i wzorzec na małe litery,
- * 2. Buduje dla tak przetworzonego wzorca automat (DFA),
- * 3. Uruchamia wyszukiwanie w przetworzonym tekście,
- * 4. Zwraca liczbę znalezionych wystąpień.
+ * Automat budowany jest od razu w trybie CaseMode::Insensitive: przejścia dla wielkiej
+ * i małej wersji każdej litery wzorca prowadzą do tego samego stanu. Dzięki temu
+ * tekst przeszukujemy w miejscu - bez kopii zamienionej na małe litery i bez
+ * dodatkowego przejścia po danych - tak samo szybko jak z rozróżnianiem wielkości liter.
  * 
  * @param text Oryginalny tekst, w którym chcemy wyszukiwać (może zawierać wielkie/male litery)
  * @param pattern Oryginalny wzorzec do wyszukiwania
  * @return Liczba dopasowań wzorca w tekście (ignorując wielkość liter)
- * 
- * @note Wewnątrz funkcji następuje zwolnienie pamięci zaalokowanej dla tablicy dfa.
  */
-int searchCaseInsensitive(const string& text, const string& pattern) {
-    // 1. Konwersja na małe litery
-    string lowerText = toLowerCase(text);
-    string lowerPattern = toLowerCase(pattern);
-
-    // 2. Budujemy automat dla "obniżonego" wzorca
-    int** dfa = buildDFA(lowerPattern);
-
-    // 3. Wyszukujemy w "obniżonym" tekście
-    int found = searchWithDFA(lowerText, lowerPattern, dfa);
+int searchCaseInsensitive(string_view text, const string& pattern) {
+    return searchWithCompactDFA(text, pattern, CaseMode::Insensitive);
+}
 
-    // Zwolnienie pamięci dfa
-    int m = lowerPattern.size();
-    for (int i = 0; i <= m; i++) {
-        delete[] dfa[i];
+/**
+ * @brief Funkcja searchFile
+ * 
+ * Przeszukuje plik odwzorowany w pamięci (zob. \ref MappedFile w mapped_file.h):
+ * automat dostaje widok na strony pliku, więc tekst nie jest kopiowany do std::string.
+ * Plik podawany jest automatowi blokami (\ref scanMappedFile), a strony przeczytanych
+ * bloków są zwalniane, więc plik może być dowolnie duży przy ograniczonym RSS.
+ * 
+ * @param pattern Wzorzec do wyszukiwania
+ * @param path Ścieżka do pliku
+ * @param mode Czy rozróżniać wielkość liter
+ * @return Kod zakończenia programu (0 oznacza sukces).
+ */
+int searchFile(const string& pattern, const string& path, CaseMode mode) {
+    try {
+        MappedFile file(path);
+        StreamingDFA dfa(pattern, mode);
+        uint64_t found = 0;
+        scanMappedFile(file, dfa, [&](uint64_t position) {
+            found++;
+            cout << "Znaleziono wystapienie wzorca na pozycji: " << position << "\n";
+        });
+        cout << "Liczba znalezionych wystapien w " << path << ": " << found << endl;
+        if constexpr (STATS_ENABLED) {
+            searchStats().print(cerr);
+        }
+    } catch (const runtime_error& error) {
+        cerr << error.what() << endl;
+        return 1;
     }
-    delete[] dfa;
-
-    return found;
+    return 0;
 }
 
 /**
  * @brief Funkcja main
  * 
- * Główna funkcja programu, w której:
+ * Główna funkcja programu. Wywołana jako `automat wzorzec plik [-i]` przeszukuje plik
+ * (\ref searchFile, opcja -i - niewrażliwie na wielkość liter). Bez argumentów:
  * 1. Następuje wczytanie wzorca oraz tekstu od użytkownika,
  * 2. Użytkownik określa, czy chce wyszukiwać niewrażliwie na wielkość liter,
  * 3. Uruchamiany jest odpowiedni tryb wyszukiwania (case-sensitive lub case-insensitive),
@@ -154,7 +209,15 @@ int searchCaseInsensitive(const string& text, const string& pattern) {
  * 
  * @return Kod zakończenia programu (0 oznacza sukces).
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc == 3 || (argc == 4 && string(argv[3]) == "-i")) {
+        return searchFile(argv[1], argv[2], argc == 4 ? CaseMode::Insensitive : CaseMode::Sensitive);
+    }
+    if (argc != 1) {
+        cerr << "Uzycie: " << argv[0] << " [wzorzec plik [-i]]" << endl;
+        return 1;
+    }
+
     // Wczytujemy wzorzec i tekst
     string pattern, text;
     cout << "Podaj wzorzec: ";
@@ -0,0 +1,213 @@
+/**
+ * @file
+ * @brief Zwarta tablica przejść automatu (DFA) z kompresją alfabetu.
+ *
+ * buildDFA w automat.cpp alokuje m+1 osobnych wierszy `new int[256]` - 1 KB na każdy
+ * znak wzorca, rozrzucony po stercie. Tutaj ten sam automat zajmuje jedną ciągłą tablicę:
+ * - bajty, które nie występują we wzorcu, zachowują się identycznie (zawsze prowadzą
+ *   tam, gdzie dowolny "obcy" znak), więc sklejamy je w jedną klasę; każdy bajt wzorca
+ *   dostaje własną klasę - wiersz ma k <= m + 1 kolumn zamiast 256,
+ * - numer stanu zapisujemy w najwęższym typie, który go pomieści (uint8_t dla m < 255,
+ *   uint16_t dla m < 65535, w przeciwnym razie uint32_t).
+ *
+ * Dla wzorca długości 32 o 10 różnych znakach tablica ma 33 * 11 bajtów zamiast 33 KB,
+ * więc razem z tablicą klas (256 B) mieści się w kilku liniach pamięci podręcznej L1.
+ *
+ * W trybie CaseMode::Insensitive wielka i mała wersja litery dostają tę samą klasę,
+ * więc prowadzą do tego samego stanu - automat ignoruje wielkość liter bez kopiowania
+ * tekstu i bez żadnej dodatkowej pracy na znak.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "../case_fold.h"
+#include "../search_stats.h"
+
+/**
+ * @brief Automat dla jednego wzorca z numerami stanów typu @p State.
+ */
+template <typename State>
+class CompactDFATable {
+private:
+    uint8_t byteClass[256]; ///< Klasa bajtu; klasa 0 - bajty spoza wzorca (jeśli są)
+    size_t classCount;
+    State accepting;        ///< Stan m - cały wzorzec dopasowany
+    std::vector<State> table; ///< table[state * classCount + klasa], (m+1) * classCount
+
+public:
+    explicit CompactDFATable(std::string_view pattern, CaseMode mode = CaseMode::Sensitive) {
+        size_t m = pattern.size();
+        accepting = (State)m;
+        bool fold = mode == CaseMode::Insensitive;
+
+        // Kompresja alfabetu: klasa 0 dla bajtów spoza wzorca, kolejne dla bajtów wzorca
+        // (bez rozróżniania wielkości liter - dla małych liter wzorca po sprowadzeniu)
+        bool used[256] = {false};
+        size_t distinct = 0;
+        for (char ch : pattern) {
+            unsigned char c = fold ? foldCase((unsigned char)ch) : (unsigned char)ch;
+            if (!used[c]) {
+                used[c] = true;
+                distinct++;
+            }
+        }
+        // Gdy wzorzec używa wszystkich 256 bajtów, klasa 0 jest zbędna
+        size_t next = distinct < 256 ? 1 : 0;
+        for (int c = 0; c < 256; c++) {
+            byteClass[c] = used[c] ? (uint8_t)next++ : 0;
+        }
+        classCount = next;
+        if (fold) {
+            for (int c = 'A'; c <= 'Z'; c++) {
+                byteClass[c] = byteClass[foldCase((unsigned char)c)]; // Ta sama klasa co mała litera
+            }
+        }
+
+        // Ta sama konstrukcja co w buildDFA, tylko na klasach zamiast bajtów
+        table.assign((m + 1) * classCount, 0);
+        if (m == 0) {
+            return;
+        }
+        table[byteClass[(unsigned char)pattern[0]]] = 1;
+        size_t fallback = 0;
+        for (size_t state = 1; state <= m; state++) {
+            State* row = &table[state * classCount];
+            const State* fallbackRow = &table[fallback * classCount];
+            for (size_t k = 0; k < classCount; k++) {
+                row[k] = fallbackRow[k];
+            }
+            if (state < m) {
+                uint8_t k = byteClass[(unsigned char)pattern[state]];
+                row[k] = (State)(state + 1);
+                fallback = fallbackRow[k];
+            }
+        }
+    }
+
+    /**
+     * @brief Przetwarza tekst, zaczynając w stanie @p state - pozwala wznowić wyszukiwanie
+     *        w kolejnym fragmencie tekstu (zob. stream_search.h).
+     *
+     * @param onMatchEnd  Wywoływane z pozycją tuż za końcem każdego dopasowania (i + 1)
+     * @return Stan automatu po ostatnim znaku
+     */
+    template <typename OnMatchEnd>
+    size_t scan(std::string_view text, size_t state, OnMatchEnd onMatchEnd) const {
+        if (accepting == 0) {
+            return 0; // Pusty wzorzec
+        }
+        const State* t = table.data();
+        DFAProbe probe;
+        for (size_t i = 0; i < text.size(); i++) {
+            state = t[state * classCount + byteClass[(unsigned char)text[i]]];
+            probe.visit(state);
+            if (state == accepting) {
+                probe.match();
+                onMatchEnd(i + 1);
+            }
+        }
+        return state;
+    }
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca, w kolejności rosnącej.
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        scan(text, 0, [&](size_t end) { onMatch(end - accepting); });
+    }
+
+    /**
+     * @brief Tylko zlicza wystąpienia - bez wywołań zwrotnych i bez skoku w pętli.
+     */
+    size_t count(std::string_view text) const {
+        if (accepting == 0) {
+            return 0;
+        }
+        const State* t = table.data();
+        size_t state = 0;
+        size_t found = 0;
+        DFAProbe probe;
+        for (size_t i = 0; i < text.size(); i++) {
+            state = t[state * classCount + byteClass[(unsigned char)text[i]]];
+            probe.visit(state);
+            found += state == accepting;
+        }
+        probe.matches = found;
+        return found;
+    }
+
+    size_t patternLength() const { return accepting; }
+
+    /**
+     * @brief Rozmiar tablicy przejść i tablicy klas w bajtach.
+     */
+    size_t tableBytes() const { return table.size() * sizeof(State) + sizeof(byteClass); }
+
+    size_t alphabetSize() const { return classCount; }
+};
+
+/**
+ * @brief Automat dla jednego wzorca z typem stanu dobranym do długości wzorca.
+ */
+class CompactDFA {
+private:
+    std::variant<CompactDFATable<uint8_t>, CompactDFATable<uint16_t>, CompactDFATable<uint32_t>>
+        table;
+
+    static decltype(table) build(std::string_view pattern, CaseMode mode) {
+        if (pattern.size() < UINT8_MAX) {
+            return CompactDFATable<uint8_t>(pattern, mode);
+        }
+        if (pattern.size() < UINT16_MAX) {
+            return CompactDFATable<uint16_t>(pattern, mode);
+        }
+        return CompactDFATable<uint32_t>(pattern, mode);
+    }
+
+public:
+    explicit CompactDFA(std::string_view pattern, CaseMode mode = CaseMode::Sensitive)
+        : table(build(pattern, mode)) {}
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca, w kolejności rosnącej.
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        std::visit([&](const auto& dfa) { dfa.search(text, onMatch); }, table);
+    }
+
+    /**
+     * @brief Wznawia wyszukiwanie w stanie @p state (zob. \ref CompactDFATable::scan).
+     */
+    template <typename OnMatchEnd>
+    size_t scan(std::string_view text, size_t state, OnMatchEnd onMatchEnd) const {
+        return std::visit([&](const auto& dfa) { return dfa.scan(text, state, onMatchEnd); },
+                          table);
+    }
+
+    size_t count(std::string_view text) const {
+        return std::visit([&](const auto& dfa) { return dfa.count(text); }, table);
+    }
+
+    size_t patternLength() const {
+        return std::visit([](const auto& dfa) { return dfa.patternLength(); }, table);
+    }
+
+    size_t tableBytes() const {
+        return std::visit([](const auto& dfa) { return dfa.tableBytes(); }, table);
+    }
+
+    /**
+     * @brief Rozmiar numeru stanu w bajtach (1, 2 lub 4).
+     */
+    size_t stateBytes() const { return table.index() == 0 ? 1 : table.index() == 1 ? 2 : 4; }
+
+    size_t alphabetSize() const {
+        return std::visit([](const auto& dfa) { return dfa.alphabetSize(); }, table);
+    }
+};
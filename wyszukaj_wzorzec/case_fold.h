@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @brief Tryb porównywania liter (z rozróżnianiem wielkości lub bez) dla algorytmów wyszukiwania.
+ *
+ * Bez rozróżniania wielkości liter 'A'..'Z' traktujemy jak 'a'..'z' (tak jak toLowerCase
+ * w dawnej wersji automat.cpp), pozostałe bajty bez zmian. Algorytmy stosują to przy
+ * porównaniach, więc tekstu nie trzeba kopiować ani zamieniać na małe litery.
+ */
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Czy wielkość liter ma znaczenie przy dopasowaniu.
+ */
+enum class CaseMode { Sensitive, Insensitive };
+
+/**
+ * @brief Mała litera dla 'A'..'Z', każdy inny bajt bez zmian.
+ */
+inline unsigned char foldCase(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Porównuje n bajtów bez rozróżniania wielkości liter.
+ */
+inline bool equalsFolded(const char* a, const char* b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (foldCase((unsigned char)a[i]) != foldCase((unsigned char)b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
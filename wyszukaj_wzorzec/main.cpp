@@ -2,9 +2,12 @@
  * @file
  * @brief Przykład wyszukiwania wzorca w tekście za pomocą różnych algorytmów.
  *
- * W pliku przedstawiono trzy metody wyszukiwania wzorca w tekście:
- * - Algorytm naiwny,
- * - Algorytm Rabina-Karpa,
+ * W pliku przedstawiono metody wyszukiwania wzorca w tekście:
+ * - Algorytm naiwny (także w wersji SIMD, zob. simd_search.h),
+ * - Algorytm Rabina-Karpa (także dla wielu wzorców),
+ * - Automat Aho-Corasick dla wielu wzorców,
+ * - Automatyczny wybór algorytmu (m.in. Horspool, Two-Way - zob. auto_search.h),
+ * - Wzorzec stały w czasie kompilacji (StaticMatcher - zob. static_matcher.h),
  * - (Wspomniany, lecz wykomentowany: automat skończony - brak implementacji w tym kodzie).
  *
  * \n\n
@@ -16,23 +19,35 @@
  */
 
 #include <iostream>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include "aho_corasick.h"
+#include "auto_search.h"
+#include "match_sinks.h"
+#include "rabin_karp.h"
+#include "search_stats.h"
+#include "simd_search.h"
+#include "static_matcher.h"
 using namespace std;
 
 /**
  * @brief Wyszukuje wzorzec w tekście metodą naiwną.
  *
  * Porównuje wzorzec ze wszystkimi możliwymi podciągami tekstu (po kolei) 
- * i w przypadku pełnej zgodności wypisuje znalezioną pozycję.
+ * i w przypadku pełnej zgodności przekazuje znalezioną pozycję do @p onMatch.
  *
  * @param text     Tekst, w którym szukamy
  * @param pattern  Wzorzec, którego szukamy
+ * @param onMatch  Wywoływane z pozycją każdego dopasowania, w kolejności rosnącej
+ *                 (np. \ref collectInto, \ref countInto z match_sinks.h)
  *
  * @note Złożoność w najgorszym przypadku to O(n*m), gdzie:
  *       - n = długość tekstu,
  *       - m = długość wzorca.
  */
-void naiveSearch(const string& text, const string& pattern) {
+template <typename OnMatch>
+void naiveSearch(const string& text, const string& pattern, OnMatch onMatch) {
     int n = text.size();     // Długość tekstu
     int m = pattern.size();  // Długość wzorca
 
@@ -48,13 +63,88 @@ void naiveSearch(const string& text, const string& pattern) {
             }
         }
 
-        // Jeśli znaleziono wzorzec, wypisujemy pozycję
+        // Jeśli znaleziono wzorzec, zgłaszamy pozycję
         if (found) {
-            cout << "Znaleziono wzorzec (naiwny) na " << i << " literce" << endl;
+            onMatch((size_t)i);
         }
     }
 }
 
+/**
+ * @brief Wyszukuje wzorzec metodą naiwną i wypisuje pozycje dopasowań.
+ */
+void naiveSearch(const string& text, const string& pattern) {
+    naiveSearch(text, pattern, [](size_t i) {
+        cout << "Znaleziono wzorzec (naiwny) na " << i << " literce\n";
+    });
+}
+
+/**
+ * @brief Zwraca pozycje wszystkich dopasowań metody naiwnej, bez wypisywania.
+ */
+vector<size_t> naiveSearchAll(const string& text, const string& pattern) {
+    vector<size_t> positions;
+    naiveSearch(text, pattern, collectInto(positions));
+    return positions;
+}
+
+/**
+ * @brief Zlicza dopasowania metody naiwnej, bez wypisywania i bez zapisywania pozycji.
+ */
+size_t naiveSearchCount(const string& text, const string& pattern) {
+    size_t count = 0;
+    naiveSearch(text, pattern, countInto(count));
+    return count;
+}
+
+/**
+ * @brief Wyszukuje wzorzec w tekście metodą naiwną przyspieszoną instrukcjami SIMD.
+ *
+ * Wynik jest taki sam jak w \ref naiveSearch, ale 16 (SSE2) lub 32 (AVX2) pozycje
+ * tekstu sprawdzane są jedną instrukcją - porównujemy tylko pierwszy i ostatni znak
+ * wzorca, a pełne porównanie wykonujemy wyłącznie dla trafień (zob. simd_search.h).
+ * Wariant dobierany jest w czasie działania programu na podstawie CPUID.
+ *
+ * @param text     Tekst, w którym szukamy
+ * @param pattern  Wzorzec, którego szukamy
+ */
+void naiveSearchSIMD(const string& text, const string& pattern) {
+    simdSearch(text, pattern, [](size_t i) {
+        cout << "Znaleziono wzorzec (naiwny SIMD) na " << i << " literce\n";
+    });
+}
+
+/**
+ * @brief Wyszukuje wzorzec algorytmem dobranym automatycznie do wzorca.
+ *
+ * \ref AutoMatcher wybiera spośród naiwnego SIMD, Horspoola, Two-Way, KMP i automatu
+ * na podstawie długości wzorca i liczby różnych znaków (zob. auto_search.h).
+ *
+ * @param text     Tekst, w którym szukamy
+ * @param pattern  Wzorzec, którego szukamy
+ */
+void autoSearch(const string& text, const string& pattern) {
+    AutoMatcher matcher(pattern);
+    cout << "Wybrany algorytm: " << engineName(matcher.engineUsed()) << "\n";
+    matcher.search(text, [](size_t i) {
+        cout << "Znaleziono wzorzec (wybor automatyczny) na " << i << " literce\n";
+    });
+}
+
+/**
+ * @brief Wyszukuje stały wzorzec "aba" automatem zbudowanym w czasie kompilacji.
+ *
+ * Tablica przejść \ref StaticMatcher powstaje podczas kompilacji programu, więc
+ * wywołanie nie buduje niczego i nie alokuje pamięci (zob. static_matcher.h).
+ *
+ * @param text  Tekst, w którym szukamy
+ */
+void staticSearchAba(const string& text) {
+    StaticMatcher<"aba">::search(text, [](size_t i) {
+        cout << "Znaleziono wzorzec (StaticMatcher<\"aba\">) na " << i << " literce\n";
+    });
+}
+
 /**
  * @brief Wyszukuje wzorzec w tekście metodą Rabina-Karpa.
  *
@@ -65,61 +155,88 @@ void naiveSearch(const string& text, const string& pattern) {
  *
  * @param text     Tekst, w którym szukamy
  * @param pattern  Wzorzec, którego szukamy
- * @param d        Baza systemu liczbowego (zwykle 256 dla ASCII)
- * @param q        Liczba pierwsza (zapobiegająca nadmiernym kolizjom)
+ * @param d        Baza systemu liczbowego (np. 256 dla ASCII)
+ * @param onMatch  Wywoływane z pozycją każdego dopasowania, w kolejności rosnącej
  *
  * ### Wyjaśnienie działania:
  * - Obliczany jest hash wzorca (p) oraz hash pierwszego podciągu tekstu (t),
  * - Następnie dla każdego kolejnego „okna” w tekście obliczany jest nowy hash (t),
  * - Jeśli hashe się zgadzają, porównujemy znak po znaku (aby uniknąć fałszywych trafień),
- * - Gdy wzorzec zostaje znaleziony, wypisywana jest pozycja w tekście.
+ * - Gdy wzorzec zostaje znaleziony, pozycja w tekście przekazywana jest do onMatch.
+ *
+ * Hash liczony jest modulo liczba Mersenne'a q = 2^61 - 1 przez \ref rabinKarp61
+ * (rabin_karp.h): redukcja to przesunięcie i dodawanie, bez dzielenia.
  *
  * @note Złożoność w przeciętnym przypadku to O(n + m). 
  *       W najgorszym przypadku może być O(n*m), jeśli występuje wiele kolizji.
  */
-void rabinKarp(const string& text, const string& pattern, int d, int q) {
-    int n = text.size();     // Długość tekstu
-    int m = pattern.size();  // Długość wzorca
+template <typename OnMatch>
+void rabinKarp(const string& text, const string& pattern, uint64_t d, OnMatch onMatch) {
+    rabinKarp61(text, pattern, onMatch, d);
+}
 
-    int h = 1; // Wartość d^(m-1) mod q
-    for (int i = 0; i < m - 1; i++) {
-        h = (h * d) % q;
-    }
+/**
+ * @brief Wyszukuje wzorzec metodą Rabina-Karpa i wypisuje pozycje dopasowań.
+ */
+void rabinKarp(const string& text, const string& pattern, uint64_t d) {
+    rabinKarp(text, pattern, d, [](size_t i) {
+        cout << "Znaleziono wzorzec (Rabin-Karp) na " << i << " literce\n";
+    });
+}
 
-    int p = 0; // Hash wzorca
-    int t = 0; // Hash bieżącego podciągu tekstu
+/**
+ * @brief Zwraca pozycje wszystkich dopasowań metody Rabina-Karpa, bez wypisywania.
+ */
+vector<size_t> rabinKarpAll(const string& text, const string& pattern, uint64_t d) {
+    vector<size_t> positions;
+    rabinKarp(text, pattern, d, collectInto(positions));
+    return positions;
+}
 
-    // Obliczenie hasha wzorca i pierwszego podciągu tekstu
-    for (int i = 0; i < m; i++) {
-        p = (d * p + pattern[i]) % q;
-        t = (d * t + text[i]) % q;
-    }
+/**
+ * @brief Zlicza dopasowania metody Rabina-Karpa, bez wypisywania i bez zapisywania pozycji.
+ */
+size_t rabinKarpCount(const string& text, const string& pattern, uint64_t d) {
+    size_t count = 0;
+    rabinKarp(text, pattern, d, countInto(count));
+    return count;
+}
 
-    // Przesuwamy wzorzec po tekście
-    for (int i = 0; i <= n - m; i++) {
-        // Jeśli hash pasuje, sprawdzamy znaki
-        if (p == t) {
-            bool found = true;
-            for (int j = 0; j < m; j++) {
-                if (text[i + j] != pattern[j]) {
-                    found = false;
-                    break;
-                }
-            }
-            if (found) {
-                cout << "Znaleziono wzorzec (Rabin-Karp) na " << i << " literce" << endl;
-            }
-        }
+/**
+ * @brief Wyszukuje wiele wzorców naraz wielowzorcowym algorytmem Rabina-Karpa.
+ *
+ * Zamiast osobnego przejścia dla każdego wzorca, jedno przejście po tekście
+ * sprawdza hasz każdego okna w tablicy odcisków wszystkich wzorców
+ * (zob. \ref MultiPatternRabinKarp w rabin_karp.h).
+ *
+ * @param text      Tekst, w którym szukamy
+ * @param patterns  Lista wzorców (np. czarna lista)
+ */
+void rabinKarpMulti(const string& text, const vector<string>& patterns) {
+    MultiPatternRabinKarp matcher(patterns);
+    matcher.search(text, [&](size_t i, size_t id) {
+        cout << "Znaleziono wzorzec \"" << matcher.pattern(id)
+             << "\" (Rabin-Karp, wiele wzorcow) na " << i << " literce\n";
+    });
+}
 
-        // Obliczenie hasha dla kolejnego podciągu tekstu
-        if (i < n - m) {
-            t = (d * (t - text[i] * h) + text[i + m]) % q;
-            // Upewniamy się, że hash jest dodatni
-            if (t < 0) {
-                t += q;
-            }
-        }
-    }
+/**
+ * @brief Wyszukuje wiele wzorców naraz automatem Aho-Corasick.
+ *
+ * Automat powstaje z drzewa trie wzorców i krawędzi fail liczonych jak tablica LPS
+ * w algorytmie KMP (zob. \ref AhoCorasick w aho_corasick.h). Jedno liniowe przejście
+ * po tekście zgłasza wszystkie dopasowania wszystkich wzorców, również wzorców
+ * różnej długości i zawartych jeden w drugim.
+ *
+ * @param text      Tekst, w którym szukamy
+ * @param patterns  Lista wzorców
+ */
+void ahoCorasickMulti(const string& text, const vector<string>& patterns) {
+    AhoCorasick automaton(patterns);
+    automaton.search(text, [&](size_t i, size_t id) {
+        cout << "Znaleziono wzorzec \"" << automaton.pattern(id)
+             << "\" (Aho-Corasick) na " << i << " literce\n";
+    });
 }
 
 /**
@@ -127,9 +244,13 @@ void rabinKarp(const string& text, const string& pattern, int d, int q) {
  *
  * W funkcji main:
  * 1. Definiowany jest przykładowy tekst i wzorzec,
- * 2. Wywoływany jest algorytm naiwny,
- * 3. Następnie wywoływany jest algorytm Rabina-Karpa (z parametrami `d=256` i `q=101`),
- * 4. Wyświetlane są informacje o znalezionych pozycjach wzorca w tekście.
+ * 2. Wywoływany jest algorytm naiwny (zwykły i SIMD), algorytm wybrany automatycznie
+ *    i automat zbudowany w czasie kompilacji,
+ * 3. Następnie wywoływany jest algorytm Rabina-Karpa (z parametrami `d=256` i `q=2^61-1`)
+ *    oraz jego wersja dla wielu wzorców naraz,
+ * 4. Te same wzorce (i wzorce różnej długości) wyszukiwane są automatem Aho-Corasick,
+ * 5. Wyświetlane są informacje o znalezionych pozycjach wzorca w tekście,
+ * 6. Na koniec te same wyniki pobierane są bez wypisywania (liczba i wektor pozycji).
  *
  * @return Kod zakończenia (0 oznacza sukces).
  */
@@ -140,8 +261,32 @@ int main() {
     cout << "Algorytm naiwny:" << endl;
     naiveSearch(text, pattern);
 
+    cout << "\nAlgorytm naiwny (SIMD):" << endl;
+    naiveSearchSIMD(text, pattern);
+
+    cout << "\nAutomatyczny wybor algorytmu:" << endl;
+    autoSearch(text, pattern);
+
+    cout << "\nWzorzec staly w czasie kompilacji:" << endl;
+    staticSearchAba(text);
+
     cout << "\nAlgorytm Rabina-Karpa:" << endl;
-    rabinKarp(text, pattern, 256, 101); // d = 256 (dla ASCII), q = 101 (liczba pierwsza)
+    // d = 256 (dla ASCII), hash modulo 2^61 - 1 (liczba pierwsza Mersenne'a)
+    rabinKarp(text, pattern, 256);
+
+    cout << "\nAlgorytm Rabina-Karpa (wiele wzorcow w jednym przejsciu):" << endl;
+    rabinKarpMulti(text, {"aba", "cab", "bac", "abc"});
+
+    cout << "\nAutomat Aho-Corasick (wiele wzorcow w jednym przejsciu):" << endl;
+    ahoCorasickMulti(text, {"aba", "cab", "bac", "abc", "ab", "abcabac"});
+
+    // Warianty bez wypisywania w pętli wyszukiwania: liczba dopasowań i lista pozycji
+    cout << "\nBez wypisywania: naiwny - " << naiveSearchCount(text, pattern)
+         << " dopasowania, Rabin-Karp - pozycje:";
+    for (size_t i : rabinKarpAll(text, pattern, 256)) {
+        cout << " " << i;
+    }
+    cout << endl;
 
     return 0;
 }
@@ -150,8 +295,13 @@ int main() {
  * @mainpage Dokumentacja - Algorytmy wyszukiwania wzorca
  * 
  * W tej dokumentacji znajdują się opisy funkcji implementujących:
- * - Wyszukiwanie **naiwne** (funkcja \ref naiveSearch),
- * - Wyszukiwanie **Rabin-Karp** (funkcja \ref rabinKarp).
+ * - Wyszukiwanie **naiwne** (funkcja \ref naiveSearch, wersja SIMD \ref naiveSearchSIMD),
+ *   bez wypisywania: \ref naiveSearchAll, \ref naiveSearchCount,
+ * - Wyszukiwanie **Rabin-Karp** (funkcja \ref rabinKarp, wiele wzorców: \ref rabinKarpMulti),
+ *   bez wypisywania: \ref rabinKarpAll, \ref rabinKarpCount,
+ * - Wyszukiwanie wielu wzorców automatem **Aho-Corasick** (funkcja \ref ahoCorasickMulti),
+ * - Automatyczny wybór algorytmu, w tym **Horspool** i **Two-Way** (funkcja \ref autoSearch),
+ * - Wzorzec znany w czasie kompilacji (funkcja \ref staticSearchAba).
  * 
  * \n
  * Aby zobaczyć kod, przejdź do pliku 
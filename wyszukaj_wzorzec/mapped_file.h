@@ -0,0 +1,117 @@
+/**
+ * @file
+ * @brief Plik wejściowy odwzorowany w pamięci (mmap) - tekst dla algorytmów bez kopiowania.
+ *
+ * Zamiast czytać tekst przez `getline(cin, text)` do std::string, plik jest odwzorowywany
+ * w przestrzeni adresowej procesu i przekazywany algorytmom jako std::string_view
+ * wskazujący bezpośrednio na strony pamięci podręcznej systemu - bez żadnej kopii.
+ *
+ * - madvise(MADV_SEQUENTIAL) - jądro czyta z wyprzedzeniem i wcześniej zwalnia
+ *   przeczytane strony,
+ * - madvise(MADV_HUGEPAGE) (jeśli dostępne) - prośba o duże strony, mniej wpisów TLB,
+ * - \ref scanMappedFile podaje odwzorowanie algorytmowi strumieniowemu blokami i po
+ *   każdym bloku oddaje jego strony (MADV_DONTNEED), więc RSS procesu pozostaje
+ *   ograniczony do kilku bloków niezależnie od wielkości pliku.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Plik tylko do odczytu odwzorowany w pamięci.
+ */
+class MappedFile {
+private:
+    const char* base = nullptr;
+    size_t mappedSize = 0;
+
+public:
+    /**
+     * @brief Odwzorowuje cały plik; nic nie jest czytane, strony ładowane są przy pierwszym dostępie.
+     * @throws std::runtime_error gdy pliku nie da się otworzyć lub odwzorować
+     */
+    explicit MappedFile(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw std::runtime_error("MappedFile: cannot stat " + path);
+        }
+        mappedSize = (size_t)info.st_size;
+        if (mappedSize == 0) {
+            close(fd); // mmap nie przyjmuje długości 0 - pusty plik to pusty widok
+            return;
+        }
+        void* mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd); // Odwzorowanie pozostaje ważne po zamknięciu deskryptora
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("MappedFile: mmap failed: " + path);
+        }
+        base = (const char*)mapped;
+        // Wskazówki dla jądra - błąd nie jest krytyczny, więc wynik jest ignorowany
+        madvise(mapped, mappedSize, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+        madvise(mapped, mappedSize, MADV_HUGEPAGE);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (base) {
+            munmap((void*)base, mappedSize);
+        }
+    }
+
+    /**
+     * @brief Cała zawartość pliku jako widok (bez kopiowania).
+     */
+    std::string_view view() const { return std::string_view(base, mappedSize); }
+
+    size_t size() const { return mappedSize; }
+
+    /**
+     * @brief Oddaje strony zakresu [offset, offset + length) - dane można nadal czytać,
+     *        jądro w razie potrzeby wczyta je ponownie z pliku.
+     */
+    void release(size_t offset, size_t length) const {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t begin = offset / page * page; // madvise wymaga adresu wyrównanego do strony
+        if (!base || begin >= mappedSize) {
+            return;
+        }
+        size_t end = std::min(offset + length, mappedSize);
+        madvise((void*)(base + begin), end - begin, MADV_DONTNEED);
+    }
+};
+
+/**
+ * @brief Przeszukuje odwzorowany plik algorytmem strumieniowym (zob. stream_search.h)
+ *        blokami, zwalniając strony za sobą - bez kopii i z ograniczonym RSS.
+ *
+ * @param file       Odwzorowany plik
+ * @param matcher    Dowolny obiekt z metodą feed(fragment, onMatch)
+ * @param onMatch    Wywoływane z globalną pozycją (od początku pliku) każdego dopasowania
+ * @param blockSize  Wielkość bloku w bajtach
+ */
+template <typename Matcher, typename OnMatch>
+void scanMappedFile(const MappedFile& file, Matcher& matcher, OnMatch onMatch,
+                    size_t blockSize = 16 << 20) {
+    std::string_view text = file.view();
+    for (size_t offset = 0; offset < text.size(); offset += blockSize) {
+        matcher.feed(text.substr(offset, blockSize), onMatch);
+        file.release(offset, blockSize);
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * @file
+ * @brief Odbiorniki dopasowań dla funkcji wyszukujących z parametrem onMatch.
+ *
+ * Wszystkie funkcje wyszukujące przyjmują onMatch(pozycja) zamiast wypisywać wynik
+ * na cout. Wypisywanie `<< endl` przy każdym trafieniu opróżnia bufor strumienia,
+ * więc w tekście gęstym od dopasowań to wejście-wyjście, a nie samo wyszukiwanie,
+ * ogranicza szybkość. Tutaj są gotowe odbiorniki bez wypisywania:
+ * - \ref collectInto - dopisuje pozycje do (np. wcześniej zarezerwowanego) wektora,
+ * - \ref writeTo     - zapisuje pozycje przez iterator wyjściowy,
+ * - \ref countInto   - tylko zlicza dopasowania.
+ *
+ * Odbiornik jest lambdą trzymającą referencję, więc można go przekazywać przez wartość.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Dopisuje pozycje dopasowań na koniec @p out (pojemność wektora jest wykorzystywana).
+ */
+template <typename Position>
+auto collectInto(std::vector<Position>& out) {
+    return [&out](size_t position) { out.push_back((Position)position); };
+}
+
+/**
+ * @brief Zapisuje pozycje dopasowań przez iterator wyjściowy @p out, przesuwając go.
+ */
+template <typename OutputIt>
+auto writeTo(OutputIt& out) {
+    return [&out](size_t position) { *out++ = position; };
+}
+
+/**
+ * @brief Zwiększa @p count przy każdym dopasowaniu.
+ */
+inline auto countInto(size_t& count) {
+    return [&count](size_t) { count++; };
+}
@@ -0,0 +1,130 @@
+/**
+ * @file
+ * @brief Wielowątkowe wyszukiwanie wzorca z podziałem tekstu na zachodzące segmenty.
+ *
+ * Tekst dzielimy na segmenty stałej wielkości [start, end). Wątek przeszukuje segment
+ * razem z m - 1 bajtami następnego segmentu, więc widzi każde dopasowanie zaczynające się
+ * w jego segmencie, także to, które przecina granicę. Zgłaszamy tylko dopasowania
+ * zaczynające się w [start, end) - każde wystąpienie ma dokładnie jednego "właściciela",
+ * więc wyniki segmentów nie powtarzają się i po sklejeniu w kolejności segmentów tworzą
+ * jedną posortowaną listę bez duplikatów.
+ *
+ * Segmentów jest dużo więcej niż wątków; wątki pobierają kolejny wolny segment
+ * z atomowego licznika, więc wątek, który skończy wcześniej (np. bo jego segmenty
+ * miały mniej dopasowań), od razu bierze następny - nikt nie czeka na najwolniejszego.
+ *
+ * Każdy wątek buduje swój obiekt wyszukujący (zob. stream_search.h) raz i między
+ * segmentami tylko go zeruje (reset()).
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "rabin_karp.h"
+#include "stream_search.h"
+
+/**
+ * @brief Algorytm używany w każdym segmencie.
+ */
+enum class SearchAlgorithm { DFA, KMP, RabinKarp, Naive };
+
+/**
+ * @brief Przeszukuje tekst równolegle obiektami tworzonymi przez @p makeMatcher.
+ *
+ * @param text         Tekst, w którym szukamy
+ * @param m            Długość wzorca (wyznacza zakładkę m - 1 między segmentami)
+ * @param makeMatcher  Funkcja zwracająca nowy obiekt z metodami feed() i reset()
+ * @param threads      Liczba wątków (0 - tyle, ile rdzeni)
+ * @param segmentSize  Wielkość segmentu w bajtach
+ * @return Posortowane pozycje wszystkich dopasowań
+ */
+template <typename MakeMatcher>
+std::vector<uint64_t> parallelSearchWith(std::string_view text, size_t m, MakeMatcher makeMatcher,
+                                         unsigned threads = 0, size_t segmentSize = 1 << 20) {
+    if (m == 0 || m > text.size()) {
+        return {};
+    }
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    segmentSize = std::max<size_t>(segmentSize, 1);
+    size_t segmentCount = (text.size() + segmentSize - 1) / segmentSize;
+    threads = (unsigned)std::min<size_t>(threads, segmentCount);
+
+    std::vector<std::vector<uint64_t>> found(segmentCount);
+    std::atomic<size_t> nextSegment{0};
+    auto worker = [&]() {
+        auto matcher = makeMatcher();
+        size_t segment;
+        while ((segment = nextSegment.fetch_add(1, std::memory_order_relaxed)) < segmentCount) {
+            size_t start = segment * segmentSize;
+            size_t end = std::min(start + segmentSize, text.size());
+            std::string_view view = text.substr(start, end - start + m - 1); // Zakładka m - 1
+            std::vector<uint64_t>& out = found[segment];
+            matcher.reset();
+            matcher.feed(view, [&](uint64_t position) {
+                if (position < end - start) { // Dopasowania od end należą do następnego segmentu
+                    out.push_back(start + position);
+                }
+            });
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker(); // Wątek wywołujący też pracuje
+    for (std::thread& w : workers) {
+        w.join();
+    }
+
+    size_t total = 0;
+    for (const auto& part : found) {
+        total += part.size();
+    }
+    std::vector<uint64_t> positions;
+    positions.reserve(total);
+    for (const auto& part : found) {
+        positions.insert(positions.end(), part.begin(), part.end());
+    }
+    return positions;
+}
+
+/**
+ * @brief Przeszukuje tekst równolegle wybranym algorytmem.
+ *
+ * @param text         Tekst, w którym szukamy
+ * @param pattern      Wzorzec (pusty wzorzec nie daje dopasowań)
+ * @param algorithm    Algorytm dla każdego segmentu
+ * @param threads      Liczba wątków (0 - tyle, ile rdzeni)
+ * @param segmentSize  Wielkość segmentu w bajtach
+ * @return Posortowane pozycje wszystkich dopasowań
+ */
+inline std::vector<uint64_t> parallelSearch(std::string_view text, std::string_view pattern,
+                                            SearchAlgorithm algorithm, unsigned threads = 0,
+                                            size_t segmentSize = 1 << 20) {
+    size_t m = pattern.size();
+    switch (algorithm) {
+    case SearchAlgorithm::DFA:
+        return parallelSearchWith(
+            text, m, [&] { return StreamingDFA(pattern); }, threads, segmentSize);
+    case SearchAlgorithm::KMP:
+        return parallelSearchWith(
+            text, m, [&] { return StreamingKMP(pattern); }, threads, segmentSize);
+    case SearchAlgorithm::RabinKarp: {
+        uint64_t base = Mersenne61::randomBase(); // Ta sama podstawa we wszystkich wątkach
+        return parallelSearchWith(
+            text, m, [&] { return StreamingRabinKarp(pattern, base); }, threads, segmentSize);
+    }
+    case SearchAlgorithm::Naive:
+        return parallelSearchWith(
+            text, m, [&] { return StreamingNaive(pattern); }, threads, segmentSize);
+    }
+    return {};
+}
@@ -0,0 +1,274 @@
+/**
+ * @file
+ * @brief Rabin-Karp na 64-bitowym haszu toczącym modulo liczba Mersenne'a 2^61 - 1.
+ *
+ * Z tej wersji korzysta rabinKarp w main.cpp. W porównaniu z haszem modulo mała liczba
+ * pierwsza (np. q = 101):
+ * - iloczyny liczymy na 128 bitach, więc nic się nie przepełnia,
+ * - przestrzeń haszy ma ~2.3 * 10^18 wartości, więc fałszywe trafienia (i ich weryfikacja)
+ *   praktycznie nie występują,
+ * - redukcja modulo 2^61 - 1 to przesunięcie i dodawanie, bez dzielenia,
+ * - podstawa d jest losowana, więc nie da się z góry przygotować tekstu z kolizjami.
+ *
+ * Klasa \ref MultiPatternRabinKarp wyszukuje tysiące wzorców w jednym przejściu:
+ * hasz każdego okna tekstu sprawdzany jest w tablicy haszującej odcisków wzorców.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "search_stats.h"
+
+/**
+ * @brief Arytmetyka modulo M = 2^61 - 1.
+ */
+struct Mersenne61 {
+    static constexpr uint64_t MOD = (1ull << 61) - 1;
+
+    static uint64_t reduce(uint64_t x) {
+        x = (x & MOD) + (x >> 61);
+        return x >= MOD ? x - MOD : x;
+    }
+
+    static uint64_t add(uint64_t a, uint64_t b) { return reduce(a + b); }
+
+    static uint64_t sub(uint64_t a, uint64_t b) { return a >= b ? a - b : a + MOD - b; }
+
+    /// Tylko dla a, b < 2^61 (już zredukowanych) - przy większym iloczynie product >> 61
+    /// nie mieści się w 64 bitach
+    static uint64_t mul(uint64_t a, uint64_t b) {
+        __uint128_t product = (__uint128_t)a * b;
+        uint64_t low = (uint64_t)product & MOD;
+        uint64_t high = (uint64_t)(product >> 61);
+        return reduce(low + high);
+    }
+
+    static uint64_t power(uint64_t base, size_t exponent) {
+        base = reduce(base);
+        uint64_t result = 1;
+        while (exponent) {
+            if (exponent & 1) result = mul(result, base);
+            base = mul(base, base);
+            exponent >>= 1;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Podstawa podana przez użytkownika sprowadzona do [0, M); 0 i 1 (po redukcji)
+     * dają hasz niezależny od kolejności znaków, więc są odrzucane (std::invalid_argument).
+     */
+    static uint64_t checkedBase(uint64_t base) {
+        base = reduce(base);
+        if (base < 2) {
+            throw std::invalid_argument("Mersenne61: base must not be 0 or 1 modulo 2^61 - 1");
+        }
+        return base;
+    }
+
+    /**
+     * @brief Losowa podstawa z przedziału [256, M - 1).
+     */
+    static uint64_t randomBase() {
+        std::random_device device;
+        std::mt19937_64 rng(((uint64_t)device() << 32) ^ device() ^
+                            (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+        return 256 + rng() % (MOD - 257);
+    }
+
+    /**
+     * @brief Hasz wielomianowy: s[0]*d^(k-1) + ... + s[k-1] (mod M).
+     */
+    static uint64_t hash(std::string_view s, uint64_t base) {
+        base = reduce(base);
+        uint64_t h = 0;
+        for (char ch : s) {
+            h = add(mul(h, base), (unsigned char)ch);
+        }
+        return h;
+    }
+};
+
+/**
+ * @brief Rabin-Karp dla jednego wzorca na haszu modulo 2^61 - 1.
+ *
+ * @param text     Tekst, w którym szukamy
+ * @param pattern  Wzorzec (pusty wzorzec nie daje dopasowań)
+ * @param onMatch  Wywoływane z pozycją każdego dopasowania, w kolejności rosnącej
+ * @param base     Podstawa d (domyślnie losowa), brana modulo 2^61 - 1; 0 i 1 rzucają
+ *                 std::invalid_argument
+ */
+template <typename OnMatch>
+void rabinKarp61(std::string_view text, std::string_view pattern, OnMatch onMatch,
+                 uint64_t base = Mersenne61::randomBase()) {
+    base = Mersenne61::checkedBase(base);
+    size_t n = text.size();
+    size_t m = pattern.size();
+    if (m == 0 || m > n) {
+        return;
+    }
+    // outWeight[c] = c * d^(m-1) mod M - wkład znaku wychodzącego z okna, bez mnożenia w pętli
+    uint64_t h = Mersenne61::power(base, m - 1);
+    uint64_t outWeight[256];
+    for (int c = 0; c < 256; c++) {
+        outWeight[c] = Mersenne61::mul(c, h);
+    }
+    uint64_t p = Mersenne61::hash(pattern, base);
+    uint64_t t = Mersenne61::hash(text.substr(0, m), base);
+    RabinKarpProbe probe;
+    for (size_t i = 0;; i++) {
+        probe.window();
+        if (p == t) {
+            probe.hashHit();
+            if (memcmp(text.data() + i, pattern.data(), m) == 0) {
+                probe.match();
+                onMatch(i);
+            }
+        }
+        if (i + m >= n) {
+            break;
+        }
+        t = Mersenne61::sub(t, outWeight[(unsigned char)text[i]]);
+        t = Mersenne61::add(Mersenne61::mul(t, base), (unsigned char)text[i + m]);
+    }
+}
+
+/**
+ * @brief Wyszukiwanie wielu wzorców jednocześnie (np. czarnej listy) w jednym przejściu.
+ *
+ * Wzorce grupowane są według długości. Dla każdej długości L utrzymujemy hasz toczący
+ * ostatnich L znaków, a odciski wzorców o tej długości trzymamy w tablicy haszującej
+ * z adresowaniem otwartym. Przy każdym znaku tekstu wykonujemy więc jedno wyszukanie
+ * w tablicy na grupę - koszt nie zależy od liczby wzorców, tylko od liczby różnych długości.
+ */
+class MultiPatternRabinKarp {
+private:
+    static constexpr uint64_t EMPTY = ~0ull; // Hasze są < 2^61, więc ta wartość jest wolna
+    static constexpr uint32_t NONE = ~0u;
+
+    /**
+     * @brief Wzorce jednej długości i tablica ich odcisków.
+     */
+    struct Group {
+        size_t length;
+        uint64_t outWeight[256];           ///< c * d^length - wkład znaku c wychodzącego z okna
+        std::vector<uint64_t> fingerprints; ///< Tablica z adresowaniem otwartym (EMPTY = wolne)
+        std::vector<uint32_t> firstPattern; ///< Pierwszy wzorzec o danym odcisku
+        uint64_t mask;
+
+        size_t slotOf(uint64_t fingerprint) const {
+            size_t slot = (size_t)((fingerprint * 0x9E3779B97F4A7C15ull) >> 20) & mask;
+            while (fingerprints[slot] != EMPTY && fingerprints[slot] != fingerprint) {
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+    };
+
+    std::vector<std::string> patterns;
+    std::vector<uint32_t> nextSameFingerprint; ///< Lista wzorców o tym samym odcisku
+    std::vector<Group> groups;
+    uint64_t base;
+
+public:
+    /**
+     * @brief Przygotowuje tablice odcisków dla podanych wzorców (puste wzorce są pomijane).
+     *
+     * Podstawa baseValue jest brana modulo 2^61 - 1, jak w \ref rabinKarp61.
+     */
+    explicit MultiPatternRabinKarp(const std::vector<std::string>& patternList,
+                                   uint64_t baseValue = Mersenne61::randomBase())
+        : patterns(patternList), nextSameFingerprint(patternList.size(), NONE),
+          base(Mersenne61::checkedBase(baseValue)) {
+        for (uint32_t id = 0; id < patterns.size(); id++) {
+            size_t length = patterns[id].size();
+            if (length == 0) {
+                continue;
+            }
+            size_t g = 0;
+            while (g < groups.size() && groups[g].length != length) {
+                g++;
+            }
+            if (g == groups.size()) {
+                groups.emplace_back();
+                groups.back().length = length;
+                uint64_t outPower = Mersenne61::power(base, length);
+                for (int c = 0; c < 256; c++) {
+                    groups.back().outWeight[c] = Mersenne61::mul(c, outPower);
+                }
+            }
+            groups[g].firstPattern.push_back(id); // Tymczasowo: lista wzorców grupy
+        }
+        for (Group& group : groups) {
+            std::vector<uint32_t> members;
+            members.swap(group.firstPattern);
+            // Tablica wypełniona w ~1/16: niemal każde okno trafia od razu w pusty slot,
+            // więc skok "brak dopasowania" jest dobrze przewidywany przez procesor
+            size_t capacity = 16;
+            while (capacity < members.size() * 16) {
+                capacity *= 2;
+            }
+            group.mask = capacity - 1;
+            group.fingerprints.assign(capacity, EMPTY);
+            group.firstPattern.assign(capacity, NONE);
+            for (uint32_t id : members) {
+                uint64_t fingerprint = Mersenne61::hash(patterns[id], base);
+                size_t slot = group.slotOf(fingerprint);
+                group.fingerprints[slot] = fingerprint;
+                nextSameFingerprint[id] = group.firstPattern[slot];
+                group.firstPattern[slot] = id;
+            }
+        }
+    }
+
+    /**
+     * @brief Przeszukuje tekst jednym przejściem.
+     *
+     * @param text     Tekst, w którym szukamy
+     * @param onMatch  Wywoływane jako onMatch(pozycja, indeks wzorca) - w kolejności
+     *                 rosnącej pozycji końca dopasowania
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        std::vector<uint64_t> hashes(groups.size(), 0);
+        const unsigned char* t = (const unsigned char*)text.data();
+        size_t n = text.size();
+        for (size_t i = 0; i < n; i++) {
+            uint64_t in = t[i];
+            for (size_t g = 0; g < groups.size(); g++) {
+                const Group& group = groups[g];
+                size_t length = group.length;
+                uint64_t h = Mersenne61::mul(hashes[g], base) + in;
+                if (i >= length) {
+                    h = Mersenne61::sub(Mersenne61::reduce(h), group.outWeight[t[i - length]]);
+                } else {
+                    h = Mersenne61::reduce(h);
+                }
+                hashes[g] = h;
+                if (i + 1 < length) {
+                    continue; // Okno jeszcze niepełne
+                }
+                size_t slot = group.slotOf(h);
+                if (group.fingerprints[slot] == EMPTY) {
+                    continue;
+                }
+                size_t start = i + 1 - length;
+                for (uint32_t id = group.firstPattern[slot]; id != NONE;
+                     id = nextSameFingerprint[id]) {
+                    if (memcmp(t + start, patterns[id].data(), length) == 0) {
+                        onMatch(start, (size_t)id);
+                    }
+                }
+            }
+        }
+    }
+
+    const std::string& pattern(size_t id) const { return patterns[id]; }
+};
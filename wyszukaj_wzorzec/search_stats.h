@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @brief Liczniki pętli wyszukiwania: Rabin-Karp, automat DFA, KMP.
+ *
+ * Liczniki kompilowane są tylko z -DALGORYTMY_STATS=1 (zob. stats.h). Bez tej flagi
+ * każda metoda sond poniżej jest pusta i pętle wyszukiwania nie zmieniają się.
+ *
+ * Pętla wyszukiwania tworzy lokalną sondę (\ref RabinKarpProbe, \ref DFAProbe,
+ * \ref KMPProbe) i zwiększa jej zwykłe, nieatomowe pola. Destruktor sondy dodaje je raz,
+ * na koniec wywołania, do liczników globalnych - więc można wyszukiwać z wielu wątków.
+ * \ref searchStats zwraca migawkę liczników, którą można wypisać (print) w trakcie
+ * działania programu, a \ref resetSearchStats je zeruje.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include "../stats.h"
+
+/**
+ * @brief Migawka liczników wszystkich algorytmów.
+ */
+struct SearchStats {
+    static constexpr size_t TRACKED_STATES = 64; ///< Stany od 64 w górę liczone razem
+
+    struct RabinKarp {
+        uint64_t windows = 0;  ///< Sprawdzone okna tekstu
+        uint64_t hashHits = 0; ///< Okna z haszem równym haszowi wzorca
+        uint64_t matches = 0;  ///< Prawdziwe dopasowania (reszta trafień to kolizje)
+    } rabinKarp;
+
+    struct DFA {
+        uint64_t bytes = 0;      ///< Przeczytane bajty tekstu
+        uint64_t matches = 0;
+        /// Odwiedziny każdego stanu q (q = liczba dopasowanych znaków) osobno, stany
+        /// od TRACKED_STATES w górę w jednym, ostatnim liczniku
+        CappedCounts<TRACKED_STATES> stateVisits;
+    } dfa;
+
+    struct KMP {
+        uint64_t characters = 0; ///< Przeczytane znaki tekstu
+        uint64_t fallbacks = 0;  ///< Cofnięcia j = lps[j - 1] (lub silnej funkcji porażki)
+        uint64_t matches = 0;
+    } kmp;
+
+    void print(std::ostream& out) const {
+        out << "Rabin-Karp: okna " << rabinKarp.windows << ", trafienia haszu "
+            << rabinKarp.hashHits << ", dopasowania " << rabinKarp.matches << ", kolizje "
+            << rabinKarp.hashHits - rabinKarp.matches << "\n";
+        out << "Automat: bajty " << dfa.bytes << ", dopasowania " << dfa.matches
+            << ", odwiedziny stanow:";
+        dfa.stateVisits.print(out);
+        out << "\nKMP: znaki " << kmp.characters << ", cofniecia " << kmp.fallbacks
+            << ", dopasowania " << kmp.matches << "\n";
+    }
+};
+
+/**
+ * @brief Globalne liczniki, do których sondy dodają swoje wyniki.
+ */
+struct SearchCounters {
+    std::atomic<uint64_t> rabinKarpWindows{0}, rabinKarpHashHits{0}, rabinKarpMatches{0};
+    std::atomic<uint64_t> dfaBytes{0}, dfaMatches{0};
+    AtomicCounts<CappedCounts<SearchStats::TRACKED_STATES>> dfaStateVisits;
+    std::atomic<uint64_t> kmpCharacters{0}, kmpFallbacks{0}, kmpMatches{0};
+};
+
+inline SearchCounters searchCounters;
+
+inline SearchStats searchStats() {
+    auto load = [](const std::atomic<uint64_t>& counter) {
+        return counter.load(std::memory_order_relaxed);
+    };
+    SearchStats stats;
+    stats.rabinKarp = {load(searchCounters.rabinKarpWindows),
+                       load(searchCounters.rabinKarpHashHits),
+                       load(searchCounters.rabinKarpMatches)};
+    stats.dfa.bytes = load(searchCounters.dfaBytes);
+    stats.dfa.matches = load(searchCounters.dfaMatches);
+    stats.dfa.stateVisits = searchCounters.dfaStateVisits.snapshot();
+    stats.kmp = {load(searchCounters.kmpCharacters), load(searchCounters.kmpFallbacks),
+                 load(searchCounters.kmpMatches)};
+    return stats;
+}
+
+inline void resetSearchStats() {
+    for (auto* counter : {&searchCounters.rabinKarpWindows, &searchCounters.rabinKarpHashHits,
+                          &searchCounters.rabinKarpMatches, &searchCounters.dfaBytes,
+                          &searchCounters.dfaMatches, &searchCounters.kmpCharacters,
+                          &searchCounters.kmpFallbacks, &searchCounters.kmpMatches}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    searchCounters.dfaStateVisits.reset();
+}
+
+namespace detail {
+inline void addCounter(std::atomic<uint64_t>& counter, uint64_t value) {
+    if (value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Sonda pętli Rabina-Karpa: okna, trafienia haszu, dopasowania.
+ */
+struct RabinKarpProbe {
+    uint64_t windows = 0, hashHits = 0, matches = 0;
+
+    void window() {
+        if constexpr (STATS_ENABLED) windows++;
+    }
+    void hashHit() {
+        if constexpr (STATS_ENABLED) hashHits++;
+    }
+    void match() {
+        if constexpr (STATS_ENABLED) matches++;
+    }
+
+    ~RabinKarpProbe() {
+        if constexpr (STATS_ENABLED) {
+            detail::addCounter(searchCounters.rabinKarpWindows, windows);
+            detail::addCounter(searchCounters.rabinKarpHashHits, hashHits);
+            detail::addCounter(searchCounters.rabinKarpMatches, matches);
+        }
+    }
+};
+
+/**
+ * @brief Sonda pętli automatu: odwiedzony stan po każdym bajcie, dopasowania.
+ */
+struct DFAProbe {
+    uint64_t matches = 0;
+    CappedCounts<SearchStats::TRACKED_STATES> stateVisits; ///< Jedna na bajt - suma to bajty
+
+    void visit(size_t state) {
+        if constexpr (STATS_ENABLED) stateVisits.record(state);
+    }
+    void match() {
+        if constexpr (STATS_ENABLED) matches++;
+    }
+
+    ~DFAProbe() {
+        if constexpr (STATS_ENABLED) {
+            detail::addCounter(searchCounters.dfaBytes, stateVisits.total());
+            detail::addCounter(searchCounters.dfaMatches, matches);
+            searchCounters.dfaStateVisits.merge(stateVisits);
+        }
+    }
+};
+
+/**
+ * @brief Sonda pętli KMP: znaki, cofnięcia po tablicy LPS, dopasowania.
+ */
+struct KMPProbe {
+    uint64_t characters = 0, fallbacks = 0, matches = 0;
+
+    void character() {
+        if constexpr (STATS_ENABLED) characters++;
+    }
+    void fallback() {
+        if constexpr (STATS_ENABLED) fallbacks++;
+    }
+    void match() {
+        if constexpr (STATS_ENABLED) matches++;
+    }
+
+    ~KMPProbe() {
+        if constexpr (STATS_ENABLED) {
+            detail::addCounter(searchCounters.kmpCharacters, characters);
+            detail::addCounter(searchCounters.kmpFallbacks, fallbacks);
+            detail::addCounter(searchCounters.kmpMatches, matches);
+        }
+    }
+};
@@ -0,0 +1,232 @@
+/**
+ * @file
+ * @brief Wyszukiwanie naiwne przyspieszone instrukcjami SIMD (SSE2 / AVX2).
+ *
+ * Zamiast porównywać wzorzec z każdą pozycją tekstu bajt po bajcie, jedną instrukcją
+ * sprawdzamy 16 (SSE2) lub 32 (AVX2) kandydujące pozycje naraz:
+ * - porównujemy blok tekstu z pierwszym znakiem wzorca (rozgłoszonym do całego rejestru),
+ * - porównujemy blok przesunięty o m-1 z ostatnim znakiem wzorca,
+ * - iloczyn obu masek wskazuje pozycje, na których pasują pierwszy i ostatni znak;
+ *   tylko dla nich porównujemy resztę wzorca (memcmp).
+ *
+ * Wariant wybierany jest w czasie działania programu (CPUID, `__builtin_cpu_supports`),
+ * a na innych architekturach zawsze używany jest przenośny wariant skalarny.
+ *
+ * Bez rozróżniania wielkości liter (CaseMode::Insensitive) blok tekstu przed porównaniem
+ * z literą wzorca przechodzi przez OR 0x20: 'A'..'Z' zamienia się wtedy w 'a'..'z',
+ * a żaden bajt spoza liter nie staje się małą literą. To jedna instrukcja więcej na blok,
+ * więc wyszukiwanie działa na oryginalnym tekście z tą samą szybkością.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include "case_fold.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_SEARCH_X86 1
+#endif
+
+/**
+ * @brief Dostępne warianty jądra wyszukiwania.
+ */
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+/**
+ * @brief Zwraca najlepszy wariant obsługiwany przez bieżący procesor.
+ */
+inline SimdLevel detectSimdLevel() {
+#ifdef SIMD_SEARCH_X86
+    static const SimdLevel level = __builtin_cpu_supports("avx2")   ? SimdLevel::AVX2
+                                   : __builtin_cpu_supports("sse2") ? SimdLevel::SSE2
+                                                                    : SimdLevel::Scalar;
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+/**
+ * @brief Wariant skalarny: klasyczne wyszukiwanie naiwne od pozycji @p from.
+ */
+template <bool IgnoreCase = false, typename OnMatch>
+void scalarSearchFrom(std::string_view text, std::string_view pattern, size_t from,
+                      OnMatch onMatch) {
+    size_t n = text.size();
+    size_t m = pattern.size();
+    for (size_t i = from; i + m <= n; i++) {
+        size_t j = 0;
+        if (IgnoreCase) {
+            while (j < m && foldCase((unsigned char)text[i + j]) == foldCase((unsigned char)pattern[j])) {
+                j++;
+            }
+        } else {
+            while (j < m && text[i + j] == pattern[j]) {
+                j++;
+            }
+        }
+        if (j == m) {
+            onMatch(i);
+        }
+    }
+}
+
+/**
+ * @brief Bajt wzorca do porównania z blokiem i maska OR dla bloku: dla liter przy
+ *        IgnoreCase - mała litera i 0x20, w pozostałych przypadkach bajt bez zmian i 0.
+ */
+template <bool IgnoreCase>
+inline void simdProbe(char patternByte, char& compareWith, char& orMask) {
+    unsigned char folded = foldCase((unsigned char)patternByte);
+    bool letter = IgnoreCase && folded >= 'a' && folded <= 'z';
+    compareWith = letter ? (char)folded : patternByte;
+    orMask = letter ? 0x20 : 0;
+}
+
+/**
+ * @brief Porównanie środka wzorca (bez pierwszego i ostatniego znaku) dla kandydata.
+ */
+template <bool IgnoreCase>
+inline bool simdVerify(const char* candidate, std::string_view pattern) {
+    size_t m = pattern.size();
+    if (m <= 2) {
+        return true;
+    }
+    return IgnoreCase ? equalsFolded(candidate + 1, pattern.data() + 1, m - 2)
+                      : memcmp(candidate + 1, pattern.data() + 1, m - 2) == 0;
+}
+
+#ifdef SIMD_SEARCH_X86
+/**
+ * @brief Jądro SSE2: 16 kandydujących pozycji na iterację.
+ * @return Pierwsza pozycja, której jądro nie sprawdziło (resztę sprawdza wariant skalarny).
+ */
+template <bool IgnoreCase = false, typename OnMatch>
+__attribute__((target("sse2")))
+size_t sse2SearchKernel(std::string_view text, std::string_view pattern, OnMatch onMatch) {
+    size_t n = text.size();
+    size_t m = pattern.size();
+    const char* t = text.data();
+    char firstByte, firstOr, lastByte, lastOr;
+    simdProbe<IgnoreCase>(pattern[0], firstByte, firstOr);
+    simdProbe<IgnoreCase>(pattern[m - 1], lastByte, lastOr);
+    const __m128i first = _mm_set1_epi8(firstByte);
+    const __m128i last = _mm_set1_epi8(lastByte);
+    const __m128i foldFirst = _mm_set1_epi8(firstOr);
+    const __m128i foldLast = _mm_set1_epi8(lastOr);
+
+    size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i*)(t + i));
+        __m128i blockLast = _mm_loadu_si128((const __m128i*)(t + i + m - 1));
+        if (IgnoreCase) {
+            blockFirst = _mm_or_si128(blockFirst, foldFirst);
+            blockLast = _mm_or_si128(blockLast, foldLast);
+        }
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast)));
+        while (mask) {
+            size_t position = i + __builtin_ctz(mask);
+            if (simdVerify<IgnoreCase>(t + position, pattern)) {
+                onMatch(position);
+            }
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Jądro AVX2: 32 kandydujące pozycje na iterację.
+ * @return Pierwsza pozycja, której jądro nie sprawdziło (resztę sprawdza wariant skalarny).
+ */
+template <bool IgnoreCase = false, typename OnMatch>
+__attribute__((target("avx2")))
+size_t avx2SearchKernel(std::string_view text, std::string_view pattern, OnMatch onMatch) {
+    size_t n = text.size();
+    size_t m = pattern.size();
+    const char* t = text.data();
+    char firstByte, firstOr, lastByte, lastOr;
+    simdProbe<IgnoreCase>(pattern[0], firstByte, firstOr);
+    simdProbe<IgnoreCase>(pattern[m - 1], lastByte, lastOr);
+    const __m256i first = _mm256_set1_epi8(firstByte);
+    const __m256i last = _mm256_set1_epi8(lastByte);
+    const __m256i foldFirst = _mm256_set1_epi8(firstOr);
+    const __m256i foldLast = _mm256_set1_epi8(lastOr);
+
+    size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(t + i));
+        __m256i blockLast = _mm256_loadu_si256((const __m256i*)(t + i + m - 1));
+        if (IgnoreCase) {
+            blockFirst = _mm256_or_si256(blockFirst, foldFirst);
+            blockLast = _mm256_or_si256(blockLast, foldLast);
+        }
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast)));
+        while (mask) {
+            size_t position = i + __builtin_ctz(mask);
+            if (simdVerify<IgnoreCase>(t + position, pattern)) {
+                onMatch(position);
+            }
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+#endif
+
+/**
+ * @brief Uruchamia wybrane jądro, a resztę tekstu sprawdza wariantem skalarnym.
+ */
+template <bool IgnoreCase, typename OnMatch>
+void simdSearchKernels(SimdLevel level, std::string_view text, std::string_view pattern,
+                       OnMatch onMatch) {
+    size_t checked = 0;
+#ifdef SIMD_SEARCH_X86
+    if (level == SimdLevel::AVX2) {
+        checked = avx2SearchKernel<IgnoreCase>(text, pattern, onMatch);
+    } else if (level == SimdLevel::SSE2) {
+        checked = sse2SearchKernel<IgnoreCase>(text, pattern, onMatch);
+    }
+#else
+    (void)level;
+#endif
+    scalarSearchFrom<IgnoreCase>(text, pattern, checked, onMatch);
+}
+
+/**
+ * @brief Wyszukuje wszystkie wystąpienia wzorca wybranym wariantem jądra.
+ *
+ * @param level    Wariant (np. z \ref detectSimdLevel)
+ * @param text     Tekst, w którym szukamy
+ * @param pattern  Wzorzec, którego szukamy (pusty wzorzec nie daje dopasowań)
+ * @param onMatch  Wywoływane z pozycją każdego dopasowania, w kolejności rosnącej
+ * @param mode     Czy rozróżniać wielkość liter
+ */
+template <typename OnMatch>
+void simdSearchWith(SimdLevel level, std::string_view text, std::string_view pattern,
+                    OnMatch onMatch, CaseMode mode = CaseMode::Sensitive) {
+    if (pattern.empty() || pattern.size() > text.size()) {
+        return;
+    }
+    if (mode == CaseMode::Insensitive) {
+        simdSearchKernels<true>(level, text, pattern, onMatch);
+    } else {
+        simdSearchKernels<false>(level, text, pattern, onMatch);
+    }
+}
+
+/**
+ * @brief Wyszukuje wszystkie wystąpienia wzorca najszybszym dostępnym wariantem.
+ *
+ * @note Złożoność w najgorszym przypadku nadal O(n*m), ale w typowym tekście pełne
+ *       porównanie wykonywane jest tylko dla pozycji, na których zgadzają się pierwszy
+ *       i ostatni znak wzorca, więc w praktyce przetwarzamy 16-32 pozycje na instrukcję.
+ */
+template <typename OnMatch>
+void simdSearch(std::string_view text, std::string_view pattern, OnMatch onMatch,
+                CaseMode mode = CaseMode::Sensitive) {
+    simdSearchWith(detectSimdLevel(), text, pattern, onMatch, mode);
+}
@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @brief Algorytmy z przeskokami: Boyer-Moore-Horspool i Two-Way (Crochemore-Perrin).
+ *
+ * Algorytm naiwny, Rabin-Karp, automat i KMP czytają każdy bajt tekstu co najmniej raz.
+ * Przy długich wzorcach (sygnatury, UUID) można lepiej:
+ * - \ref HorspoolMatcher porównuje okno od końca, a po niedopasowaniu przesuwa je
+ *   o odległość ostatniego znaku okna od końca wzorca - w typowym tekście o prawie m,
+ *   więc czyta tylko ok. n/m bajtów. W najgorszym przypadku O(n*m).
+ * - \ref TwoWayMatcher dzieli wzorzec w punkcie krytycznym na x = u v i dopasowuje
+ *   najpierw v od lewej, potem u od prawej. Czas w najgorszym przypadku O(n + m),
+ *   dodatkowa pamięć O(1) (tylko kilka liczb, bez tablic), w typowym tekście też
+ *   przeskakuje fragmenty okna.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Wyszukiwanie Boyera-Moore'a-Horspoola (tylko reguła złego znaku).
+ */
+class HorspoolMatcher {
+private:
+    std::string pattern;
+    size_t shift[256]; ///< shift[c] - przesunięcie okna, gdy jego ostatni bajt to c
+
+public:
+    explicit HorspoolMatcher(std::string_view patternText) : pattern(patternText) {
+        size_t m = pattern.size();
+        for (size_t& s : shift) {
+            s = m;
+        }
+        for (size_t i = 0; i + 1 < m; i++) {
+            shift[(unsigned char)pattern[i]] = m - 1 - i;
+        }
+    }
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca, w kolejności rosnącej.
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        size_t n = text.size();
+        size_t m = pattern.size();
+        if (m == 0 || m > n) {
+            return;
+        }
+        const char* t = text.data();
+        const char* p = pattern.data();
+        unsigned char last = (unsigned char)p[m - 1];
+        size_t i = 0;
+        while (i <= n - m) {
+            unsigned char c = (unsigned char)t[i + m - 1];
+            if (c == last && memcmp(t + i, p, m - 1) == 0) {
+                onMatch(i);
+            }
+            i += shift[c];
+        }
+    }
+};
+
+/**
+ * @brief Algorytm Two-Way (Crochemore-Perrin): liniowy w najgorszym przypadku, O(1) pamięci.
+ */
+class TwoWayMatcher {
+private:
+    std::string pattern;
+    long critical; ///< Ostatnia pozycja u w podziale x = u v (może być -1)
+    long period;   ///< Okres wzorca lub ograniczenie przesunięcia (wzorzec nieokresowy)
+    bool periodic; ///< Czy u jest sufiksem v[0, period) - wtedy pamiętamy dopasowany prefiks
+
+    /**
+     * @brief Maksymalny sufiks wzorca w porządku leksykograficznym (lub odwróconym).
+     * @return Pozycja przed początkiem sufiksu; w @p p - okres sufiksu
+     */
+    static long maximalSuffix(std::string_view x, bool reversed, long& p) {
+        long m = (long)x.size();
+        long ms = -1, j = 0, k = 1;
+        p = 1;
+        while (j + k < m) {
+            unsigned char a = (unsigned char)x[j + k];
+            unsigned char b = (unsigned char)x[ms + k];
+            if (reversed ? a > b : a < b) {
+                j += k;
+                k = 1;
+                p = j - ms;
+            } else if (a == b) {
+                if (k != p) {
+                    k++;
+                } else {
+                    j += p;
+                    k = 1;
+                }
+            } else {
+                ms = j;
+                j = ms + 1;
+                k = p = 1;
+            }
+        }
+        return ms;
+    }
+
+public:
+    explicit TwoWayMatcher(std::string_view patternText) : pattern(patternText) {
+        long m = (long)pattern.size();
+        critical = -1;
+        period = 1;
+        periodic = false;
+        if (m == 0) {
+            return;
+        }
+        // Punkt krytyczny: dłuższy z dwóch maksymalnych sufiksów (dla obu porządków)
+        long p, q;
+        long i = maximalSuffix(pattern, false, p);
+        long j = maximalSuffix(pattern, true, q);
+        critical = i > j ? i : j;
+        period = i > j ? p : q;
+        periodic = period + critical + 1 <= m &&
+                   memcmp(pattern.data(), pattern.data() + period, critical + 1) == 0;
+        if (!periodic) {
+            long left = critical + 1, right = m - critical - 1;
+            period = (left > right ? left : right) + 1;
+        }
+    }
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca, w kolejności rosnącej.
+     */
+    template <typename OnMatch>
+    void search(std::string_view text, OnMatch onMatch) const {
+        long n = (long)text.size();
+        long m = (long)pattern.size();
+        if (m == 0 || m > n) {
+            return;
+        }
+        const char* x = pattern.data();
+        const char* y = text.data();
+        long j = 0;
+        if (periodic) {
+            long memory = -1; // Długość prefiksu wzorca dopasowanego w poprzednim oknie
+            while (j <= n - m) {
+                long i = (critical > memory ? critical : memory) + 1;
+                while (i < m && x[i] == y[i + j]) {
+                    i++;
+                }
+                if (i >= m) {
+                    i = critical;
+                    while (i > memory && x[i] == y[i + j]) {
+                        i--;
+                    }
+                    if (i <= memory) {
+                        onMatch((size_t)j);
+                    }
+                    j += period;
+                    memory = m - period - 1;
+                } else {
+                    j += i - critical;
+                    memory = -1;
+                }
+            }
+        } else {
+            while (j <= n - m) {
+                long i = critical + 1;
+                while (i < m && x[i] == y[i + j]) {
+                    i++;
+                }
+                if (i >= m) {
+                    i = critical;
+                    while (i >= 0 && x[i] == y[i + j]) {
+                        i--;
+                    }
+                    if (i < 0) {
+                        onMatch((size_t)j);
+                    }
+                    j += period;
+                } else {
+                    j += i - critical;
+                }
+            }
+        }
+    }
+};
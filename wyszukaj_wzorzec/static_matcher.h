@@ -0,0 +1,213 @@
+/**
+ * @file
+ * @brief Wyszukiwanie wzorca znanego w czasie kompilacji - tablice liczone przez kompilator.
+ *
+ * buildDFA (automat.cpp) i computeLPSArray (main_KPM.cpp) budują swoje tablice przy
+ * każdym wywołaniu i alokują je na stercie. Jeśli wzorzec jest stałą w programie, całą
+ * tę pracę może wykonać kompilator:
+ * - \ref constexprLPS i \ref constexprDFA to wersje constexpr tych funkcji - wynik jest
+ *   std::array, bez alokacji,
+ * - \ref StaticMatcher "StaticMatcher<"wzorzec">" trzyma tablicę LPS i zwarty automat
+ *   (klasy bajtów jak w compact_dfa.h) jako `static constexpr` - leżą w sekcji tylko do
+ *   odczytu pliku wykonywalnego, więc start programu nic nie kosztuje, a wyszukiwanie
+ *   nie alokuje pamięci. Kompilator zna długość wzorca i zawartość tablic, więc pętlę
+ *   może w pełni wyspecjalizować; porównanie wzorca w \ref StaticMatcher::matchesAt jest
+ *   rozwinięte (jedno porównanie na znak, bez pętli).
+ *
+ * Wszystkie funkcje są constexpr, więc wyszukiwanie działa też w czasie kompilacji:
+ * `static_assert(StaticMatcher<"aba">::count("abcabaabcabac") == 2);`
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Literał napisowy jako parametr szablonu: StaticMatcher<"abc">.
+ */
+template <size_t N>
+struct FixedPattern {
+    char chars[N] = {};
+
+    constexpr FixedPattern(const char (&text)[N]) {
+        for (size_t i = 0; i < N; i++) {
+            chars[i] = text[i];
+        }
+    }
+
+    static constexpr size_t size() { return N - 1; } // Bez kończącego '\0'
+
+    constexpr std::string_view view() const { return std::string_view(chars, N - 1); }
+};
+
+/**
+ * @brief Tablica LPS wzorca, liczona jak w computeLPSArray, ale constexpr i bez alokacji.
+ */
+template <FixedPattern Pattern>
+constexpr std::array<int, Pattern.size()> constexprLPS() {
+    constexpr size_t m = Pattern.size();
+    std::array<int, m> lps = {};
+    size_t length = 0;
+    for (size_t i = 1; i < m;) {
+        if (Pattern.chars[i] == Pattern.chars[length]) {
+            lps[i++] = (int)++length;
+        } else if (length != 0) {
+            length = lps[length - 1];
+        } else {
+            lps[i++] = 0;
+        }
+    }
+    return lps;
+}
+
+/**
+ * @brief Pełna tablica przejść (m+1) x 256, jak w buildDFA, ale constexpr i bez alokacji.
+ */
+template <FixedPattern Pattern>
+constexpr std::array<std::array<int, 256>, Pattern.size() + 1> constexprDFA() {
+    constexpr size_t m = Pattern.size();
+    std::array<std::array<int, 256>, m + 1> dfa = {};
+    if constexpr (m > 0) {
+        dfa[0][(unsigned char)Pattern.chars[0]] = 1;
+        size_t fallback = 0;
+        for (size_t state = 1; state <= m; state++) {
+            dfa[state] = dfa[fallback];
+            if (state < m) {
+                dfa[state][(unsigned char)Pattern.chars[state]] = (int)state + 1;
+                fallback = dfa[fallback][(unsigned char)Pattern.chars[state]];
+            }
+        }
+    }
+    return dfa;
+}
+
+namespace static_matcher_detail {
+
+/// Klasa każdego bajtu: 0 - bajt spoza wzorca, 1..k - kolejne różne bajty wzorca
+template <FixedPattern Pattern>
+constexpr std::array<uint8_t, 256> byteClasses() {
+    std::array<uint8_t, 256> classes = {};
+    uint8_t next = 1;
+    for (size_t i = 0; i < Pattern.size(); i++) {
+        unsigned char c = (unsigned char)Pattern.chars[i];
+        if (classes[c] == 0) {
+            classes[c] = next++;
+        }
+    }
+    return classes;
+}
+
+template <FixedPattern Pattern>
+constexpr size_t classCount() {
+    size_t highest = 0;
+    for (uint8_t k : byteClasses<Pattern>()) {
+        highest = k > highest ? k : highest;
+    }
+    return highest + 1;
+}
+
+/// Zwarty automat: wiersz na stan, kolumna na klasę bajtów (zob. compact_dfa.h)
+template <FixedPattern Pattern, typename State>
+constexpr std::array<State, (Pattern.size() + 1) * classCount<Pattern>()> transitions() {
+    constexpr size_t m = Pattern.size();
+    constexpr size_t k = classCount<Pattern>();
+    constexpr std::array<uint8_t, 256> classes = byteClasses<Pattern>();
+    std::array<State, (m + 1) * k> table = {};
+    table[classes[(unsigned char)Pattern.chars[0]]] = 1;
+    size_t fallback = 0;
+    for (size_t state = 1; state <= m; state++) {
+        for (size_t c = 0; c < k; c++) {
+            table[state * k + c] = table[fallback * k + c];
+        }
+        if (state < m) {
+            uint8_t c = classes[(unsigned char)Pattern.chars[state]];
+            table[state * k + c] = (State)(state + 1);
+            fallback = table[fallback * k + c];
+        }
+    }
+    return table;
+}
+
+} // namespace static_matcher_detail
+
+/**
+ * @brief Wyszukiwanie wzorca podanego jako parametr szablonu.
+ */
+template <FixedPattern Pattern>
+class StaticMatcher {
+public:
+    static constexpr size_t length = Pattern.size();
+    static_assert(length > 0, "StaticMatcher: pusty wzorzec");
+
+    /// Najwęższy typ mieszczący numer stanu (jak w CompactDFA)
+    using State = std::conditional_t<(length < UINT8_MAX), uint8_t, uint16_t>;
+
+    static constexpr std::array<int, length> lps = constexprLPS<Pattern>();
+    static constexpr std::array<uint8_t, 256> byteClass =
+        static_matcher_detail::byteClasses<Pattern>();
+    static constexpr size_t classCount = static_matcher_detail::classCount<Pattern>();
+    static constexpr auto transitions = static_matcher_detail::transitions<Pattern, State>();
+
+    /**
+     * @brief Czy wzorzec występuje na pozycji @p text (co najmniej length bajtów)?
+     *        Porównanie rozwinięte przez kompilator - po jednym porównaniu na znak.
+     */
+    static constexpr bool matchesAt(const char* text) {
+        return [text]<size_t... I>(std::index_sequence<I...>) {
+            return ((text[I] == Pattern.chars[I]) && ...);
+        }(std::make_index_sequence<length>());
+    }
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca, w kolejności rosnącej.
+     *
+     * Jeden odczyt z tablicy constexpr na znak tekstu, bez cofania (jak searchWithDFA).
+     */
+    template <typename OnMatch>
+    static constexpr void search(std::string_view text, OnMatch onMatch) {
+        size_t state = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            state = transitions[state * classCount + byteClass[(unsigned char)text[i]]];
+            if (state == length) {
+                onMatch(i + 1 - length);
+            }
+        }
+    }
+
+    /**
+     * @brief Zlicza wystąpienia - bez wywołań zwrotnych i bez skoku w pętli.
+     */
+    static constexpr size_t count(std::string_view text) {
+        size_t state = 0;
+        size_t found = 0;
+        for (size_t i = 0; i < text.size(); i++) {
+            state = transitions[state * classCount + byteClass[(unsigned char)text[i]]];
+            found += state == length;
+        }
+        return found;
+    }
+
+    /**
+     * @brief Pozycja pierwszego wystąpienia lub std::string_view::npos.
+     *
+     * Dla krótkich wzorców szybsze od automatu: szukamy pierwszego znaku wzorca
+     * i sprawdzamy resztę rozwiniętym \ref matchesAt.
+     */
+    static constexpr size_t find(std::string_view text, size_t from = 0) {
+        if (text.size() < length) {
+            return std::string_view::npos;
+        }
+        for (size_t i = text.find(Pattern.chars[0], from); i != std::string_view::npos &&
+                                                          i <= text.size() - length;
+             i = text.find(Pattern.chars[0], i + 1)) {
+            if (matchesAt(text.data() + i)) {
+                return i;
+            }
+        }
+        return std::string_view::npos;
+    }
+};
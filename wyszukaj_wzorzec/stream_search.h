@@ -0,0 +1,298 @@
+/**
+ * @file
+ * @brief Wyszukiwanie wzorca w strumieniu danych podawanych fragmentami.
+ *
+ * Funkcje z main.cpp, automat.cpp i main_KPM.cpp potrzebują całego tekstu w jednym
+ * std::string, więc plik wielogigabajtowy trzeba by najpierw wczytać do pamięci.
+ * Tutaj każdy algorytm jest obiektem, który pamięta swój stan między wywołaniami
+ * `feed(fragment, onMatch)`:
+ * - \ref StreamingDFA   - numer stanu automatu,
+ * - \ref StreamingKMP   - indeks j we wzorcu (długość bieżącego dopasowania),
+ * - \ref StreamingRabinKarp - hasz toczący i ostatnie m bajtów (znaki wychodzące z okna),
+ * - \ref StreamingNaive - ostatnie m - 1 bajtów poprzedniego fragmentu.
+ *
+ * StreamingDFA, StreamingKMP i StreamingNaive przyjmują też CaseMode::Insensitive -
+ * wielkość liter jest wtedy ignorowana bez kopiowania tekstu (zob. case_fold.h).
+ *
+ * Dopasowania przecinające granicę fragmentów są wykrywane, a onMatch(pozycja) dostaje
+ * zawsze pozycję globalną - liczoną od początku całego strumienia, nie fragmentu.
+ * Funkcja \ref scanFile czyta plik blokami stałej wielkości i podaje je wybranemu algorytmowi.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "automat_wyszukiwanie_wzorca/compact_dfa.h"
+#include "rabin_karp.h"
+#include "search_stats.h"
+#include "simd_search.h"
+
+/**
+ * @brief Automat skończony (zwarta tablica z compact_dfa.h) wznawiany między fragmentami.
+ */
+class StreamingDFA {
+private:
+    CompactDFA dfa;
+    size_t state = 0;
+    uint64_t consumed = 0; ///< Liczba bajtów podanych we wcześniejszych fragmentach
+
+public:
+    explicit StreamingDFA(std::string_view pattern, CaseMode mode = CaseMode::Sensitive)
+        : dfa(pattern, mode) {}
+
+    template <typename OnMatch>
+    void feed(std::string_view chunk, OnMatch onMatch) {
+        uint64_t offset = consumed;
+        size_t m = dfa.patternLength();
+        state = dfa.scan(chunk, state, [&](size_t end) { onMatch(offset + end - m); });
+        consumed += chunk.size();
+    }
+
+    void reset() {
+        state = 0;
+        consumed = 0;
+    }
+
+    uint64_t bytesConsumed() const { return consumed; }
+};
+
+/**
+ * @brief Algorytm KMP wznawiany między fragmentami - stanem jest tylko indeks j.
+ */
+class StreamingKMP {
+private:
+    std::string pattern;   ///< Przy CaseMode::Insensitive - sprowadzony do małych liter
+    std::vector<int> lps;
+    unsigned char fold[256]; ///< Tłumaczenie bajtu tekstu przed porównaniem (lub tożsamość)
+    size_t j = 0; ///< Liczba znaków wzorca dopasowanych na końcu dotychczasowego strumienia
+    uint64_t consumed = 0;
+
+public:
+    explicit StreamingKMP(std::string_view patternText, CaseMode mode = CaseMode::Sensitive)
+        : pattern(patternText), lps(pattern.size()) {
+        for (int c = 0; c < 256; c++) {
+            fold[c] = mode == CaseMode::Insensitive ? foldCase((unsigned char)c) : (unsigned char)c;
+        }
+        for (char& ch : pattern) {
+            ch = (char)fold[(unsigned char)ch];
+        }
+        // Tablica LPS jak w computeLPSArray (main_KPM.cpp), bez wypisywania kroków
+        size_t length = 0;
+        for (size_t i = 1; i < pattern.size();) {
+            if (pattern[i] == pattern[length]) {
+                lps[i++] = (int)++length;
+            } else if (length != 0) {
+                length = lps[length - 1];
+            } else {
+                lps[i++] = 0;
+            }
+        }
+    }
+
+    template <typename OnMatch>
+    void feed(std::string_view chunk, OnMatch onMatch) {
+        size_t m = pattern.size();
+        if (m == 0) {
+            consumed += chunk.size();
+            return;
+        }
+        KMPProbe probe;
+        for (size_t i = 0; i < chunk.size(); i++) {
+            char ch = (char)fold[(unsigned char)chunk[i]];
+            probe.character();
+            while (j != 0 && ch != pattern[j]) {
+                probe.fallback();
+                j = lps[j - 1];
+            }
+            if (ch == pattern[j]) {
+                j++;
+            }
+            if (j == m) {
+                probe.match();
+                onMatch(consumed + i + 1 - m);
+                j = lps[j - 1];
+            }
+        }
+        consumed += chunk.size();
+    }
+
+    void reset() {
+        j = 0;
+        consumed = 0;
+    }
+
+    uint64_t bytesConsumed() const { return consumed; }
+};
+
+/**
+ * @brief Rabin-Karp (hasz modulo 2^61 - 1, zob. rabin_karp.h) wznawiany między fragmentami.
+ *
+ * Znak wychodzący z okna może pochodzić z poprzedniego fragmentu, więc ostatnie m bajtów
+ * strumienia trzymamy w buforze cyklicznym; z niego też weryfikujemy trafienia haszu.
+ */
+class StreamingRabinKarp {
+private:
+    std::string pattern;
+    uint64_t base;
+    uint64_t patternHash;
+    uint64_t outWeight[256]; ///< c * d^(m-1) - wkład znaku wychodzącego z okna
+    std::string window;      ///< Ostatnie m bajtów strumienia (bufor cykliczny)
+    size_t windowPos = 0;    ///< Najstarszy bajt okna (gdy okno jest pełne)
+    uint64_t hash = 0;
+    uint64_t consumed = 0;
+
+    bool windowMatches() const {
+        size_t m = pattern.size();
+        size_t head = m - windowPos; // Bajty od windowPos do końca bufora
+        return memcmp(window.data() + windowPos, pattern.data(), head) == 0 &&
+               memcmp(window.data(), pattern.data() + head, windowPos) == 0;
+    }
+
+public:
+    explicit StreamingRabinKarp(std::string_view patternText,
+                                uint64_t baseValue = Mersenne61::randomBase())
+        : pattern(patternText), base(baseValue), window(patternText.size(), '\0') {
+        patternHash = Mersenne61::hash(pattern, base);
+        uint64_t h = pattern.empty() ? 0 : Mersenne61::power(base, pattern.size() - 1);
+        for (int c = 0; c < 256; c++) {
+            outWeight[c] = Mersenne61::mul(c, h);
+        }
+    }
+
+    template <typename OnMatch>
+    void feed(std::string_view chunk, OnMatch onMatch) {
+        size_t m = pattern.size();
+        if (m == 0) {
+            consumed += chunk.size();
+            return;
+        }
+        RabinKarpProbe probe;
+        for (size_t i = 0; i < chunk.size(); i++) {
+            unsigned char in = (unsigned char)chunk[i];
+            uint64_t position = consumed + i; // Globalna pozycja wchodzącego znaku
+            if (position >= m) {
+                hash = Mersenne61::sub(hash, outWeight[(unsigned char)window[windowPos]]);
+            }
+            hash = Mersenne61::add(Mersenne61::mul(hash, base), in);
+            window[windowPos] = (char)in;
+            windowPos = windowPos + 1 == m ? 0 : windowPos + 1;
+            if (position + 1 >= m) {
+                probe.window();
+                if (hash == patternHash) {
+                    probe.hashHit();
+                    if (windowMatches()) {
+                        probe.match();
+                        onMatch(position + 1 - m);
+                    }
+                }
+            }
+        }
+        consumed += chunk.size();
+    }
+
+    void reset() {
+        windowPos = 0;
+        hash = 0;
+        consumed = 0;
+    }
+
+    uint64_t bytesConsumed() const { return consumed; }
+};
+
+/**
+ * @brief Wyszukiwanie naiwne (wariant SIMD z simd_search.h) wznawiane między fragmentami.
+ *
+ * Wnętrze fragmentu przeszukuje simdSearch; dopasowania przecinające granicę sprawdzamy
+ * w krótkim buforze: ostatnie m - 1 bajtów poprzedniego fragmentu + pierwsze m - 1 bajtów
+ * bieżącego.
+ */
+class StreamingNaive {
+private:
+    std::string pattern;
+    std::string tail; ///< Ostatnie (co najwyżej m - 1) bajtów dotychczasowego strumienia
+    std::string seam; ///< Bufor roboczy do sprawdzania granicy fragmentów
+    CaseMode mode;
+    uint64_t consumed = 0;
+
+public:
+    explicit StreamingNaive(std::string_view patternText, CaseMode caseMode = CaseMode::Sensitive)
+        : pattern(patternText), mode(caseMode) {}
+
+    template <typename OnMatch>
+    void feed(std::string_view chunk, OnMatch onMatch) {
+        size_t m = pattern.size();
+        if (m == 0) {
+            consumed += chunk.size();
+            return;
+        }
+        // Dopasowania zaczynające się w tail, a kończące w chunk
+        if (!tail.empty()) {
+            seam.assign(tail);
+            seam.append(chunk.substr(0, m - 1));
+            uint64_t seamStart = consumed - tail.size();
+            simdSearch(seam, pattern, [&](size_t i) {
+                if (i < tail.size()) {
+                    onMatch(seamStart + i);
+                }
+            }, mode);
+        }
+        simdSearch(chunk, pattern, [&](size_t i) { onMatch(consumed + i); }, mode);
+        consumed += chunk.size();
+
+        // Nowy ogon: ostatnie m - 1 bajtów strumienia (może obejmować stary ogon)
+        if (chunk.size() >= m - 1) {
+            tail.assign(chunk.substr(chunk.size() - (m - 1)));
+        } else {
+            tail.append(chunk);
+            if (tail.size() > m - 1) {
+                tail.erase(0, tail.size() - (m - 1));
+            }
+        }
+    }
+
+    void reset() {
+        tail.clear();
+        consumed = 0;
+    }
+
+    uint64_t bytesConsumed() const { return consumed; }
+};
+
+/**
+ * @brief Przeszukuje plik blokami stałej wielkości - w pamięci jest zawsze jeden blok.
+ *
+ * @param path       Ścieżka do pliku
+ * @param matcher    Dowolny z obiektów Streaming* (jego stan jest kontynuowany)
+ * @param onMatch    Wywoływane z globalną pozycją (od początku pliku) każdego dopasowania
+ * @param blockSize  Wielkość bloku w bajtach
+ * @return Liczba przeczytanych bajtów
+ *
+ * @throws std::runtime_error gdy pliku nie da się otworzyć lub odczytać
+ */
+template <typename Matcher, typename OnMatch>
+uint64_t scanFile(const std::string& path, Matcher& matcher, OnMatch onMatch,
+                  size_t blockSize = 1 << 20) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("scanFile: cannot open " + path);
+    }
+    std::vector<char> block(blockSize);
+    uint64_t total = 0;
+    size_t got;
+    while ((got = fread(block.data(), 1, block.size(), file)) > 0) {
+        matcher.feed(std::string_view(block.data(), got), onMatch);
+        total += got;
+    }
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    if (failed) {
+        throw std::runtime_error("scanFile: read failed: " + path);
+    }
+    return total;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file
+ * @brief Tablica sufiksów z tablicą LCP - indeks stałego tekstu dla wielu zapytań.
+ *
+ * Wszystkie pozostałe algorytmy (automat, KMP, Rabin-Karp, Horspool...) czytają cały
+ * tekst przy każdym zapytaniu - koszt O(n) na wzorzec. Gdy tekst się nie zmienia, a
+ * wzorców jest wiele, opłaca się raz zbudować indeks:
+ * - tablica sufiksów budowana algorytmem SA-IS (Nong, Zhang, Chan) w czasie O(n),
+ * - tablica LCP (najdłuższy wspólny prefiks sąsiednich sufiksów) algorytmem Kasaia, O(n),
+ * - \ref SuffixArrayIndex::count - dwa wyszukiwania binarne, O(m log n) niezależnie od
+ *   liczby wystąpień,
+ * - \ref SuffixArrayIndex::locate - jedno wyszukiwanie binarne, a koniec przedziału
+ *   wystąpień odczytany z tablicy LCP: O(m log n + occ).
+ *
+ * Wyszukiwanie binarne pamięta, ile znaków wzorca zgadza się z lewym i prawym końcem
+ * przedziału, i zaczyna porównanie od mniejszej z tych wartości - w praktyce prawie
+ * każdy znak wzorca porównywany jest raz.
+ *
+ * Indeks zajmuje 9n bajtów (tekst + dwie tablice int32_t) i można go zapisać do pliku
+ * (\ref SuffixArrayIndex::save) i wczytać bez ponownego budowania
+ * (\ref SuffixArrayIndex::load). Tekst może mieć najwyżej 2^31 - 1 bajtów.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace suffix_array_detail {
+
+/**
+ * @brief SA-IS: tablica sufiksów napisu @p s o znakach 0..upper.
+ *
+ * Sufiksy dzielone są na typy S (mniejszy od następnego) i L (większy). Sufiksy LMS
+ * (typ S poprzedzony typem L) są sortowane rekurencyjnie na napisie o n/2 znakach,
+ * a pozostałe ustawiane w kubełkach przez dwa przebiegi indukcji.
+ */
+template <typename Char>
+std::vector<int32_t> sais(const Char* s, int32_t n, int32_t upper) {
+    if (n == 0) {
+        return {};
+    }
+    if (n == 1) {
+        return {0};
+    }
+    if (n == 2) {
+        return s[0] < s[1] ? std::vector<int32_t>{0, 1} : std::vector<int32_t>{1, 0};
+    }
+
+    std::vector<int32_t> sa(n);
+    std::vector<uint8_t> isS(n, 0); // 1 - sufiks typu S
+    for (int32_t i = n - 2; i >= 0; i--) {
+        isS[i] = s[i] == s[i + 1] ? isS[i + 1] : s[i] < s[i + 1];
+    }
+    // Początki kubełków: sufiksy L znaku c zaczynają się na bucketL[c], sufiksy S na bucketS[c]
+    std::vector<int32_t> bucketL(upper + 2, 0), bucketS(upper + 2, 0);
+    for (int32_t i = 0; i < n; i++) {
+        if (!isS[i]) {
+            bucketS[s[i]]++;
+        } else {
+            bucketL[s[i] + 1]++;
+        }
+    }
+    for (int32_t c = 0; c <= upper; c++) {
+        bucketS[c] += bucketL[c];
+        bucketL[c + 1] += bucketS[c];
+    }
+
+    std::vector<int32_t> next(upper + 2);
+    auto induce = [&](const std::vector<int32_t>& lms) {
+        std::fill(sa.begin(), sa.end(), -1);
+        std::copy(bucketS.begin(), bucketS.end(), next.begin());
+        for (int32_t position : lms) {
+            sa[next[s[position]]++] = position;
+        }
+        // Sufiksy L od lewej: jeśli sa[i] jest poprzedzony sufiksem L, ten idzie na początek kubełka
+        std::copy(bucketL.begin(), bucketL.end(), next.begin());
+        sa[next[s[n - 1]]++] = n - 1;
+        for (int32_t i = 0; i < n; i++) {
+            int32_t v = sa[i];
+            if (v >= 1 && !isS[v - 1]) {
+                sa[next[s[v - 1]]++] = v - 1;
+            }
+        }
+        // Sufiksy S od prawej, na koniec swoich kubełków
+        std::copy(bucketL.begin(), bucketL.end(), next.begin());
+        for (int32_t i = n - 1; i >= 0; i--) {
+            int32_t v = sa[i];
+            if (v >= 1 && isS[v - 1]) {
+                sa[--next[s[v - 1] + 1]] = v - 1;
+            }
+        }
+    };
+
+    std::vector<int32_t> lmsIndex(n + 1, -1);
+    std::vector<int32_t> lms;
+    for (int32_t i = 1; i < n; i++) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsIndex[i] = (int32_t)lms.size();
+            lms.push_back(i);
+        }
+    }
+    int32_t m = (int32_t)lms.size();
+    induce(lms);
+    if (m == 0) {
+        return sa;
+    }
+
+    // Nazwy podciągów LMS w kolejności po indukcji; równe podciągi dostają tę samą nazwę
+    std::vector<int32_t> sortedLms;
+    sortedLms.reserve(m);
+    for (int32_t v : sa) {
+        if (lmsIndex[v] != -1) {
+            sortedLms.push_back(v);
+        }
+    }
+    std::vector<int32_t> reduced(m);
+    int32_t name = 0;
+    reduced[lmsIndex[sortedLms[0]]] = 0;
+    for (int32_t i = 1; i < m; i++) {
+        int32_t left = sortedLms[i - 1], right = sortedLms[i];
+        int32_t endLeft = lmsIndex[left] + 1 < m ? lms[lmsIndex[left] + 1] : n;
+        int32_t endRight = lmsIndex[right] + 1 < m ? lms[lmsIndex[right] + 1] : n;
+        bool same = endLeft - left == endRight - right;
+        if (same) {
+            while (left < endLeft && s[left] == s[right]) {
+                left++;
+                right++;
+            }
+            same = left != n && s[left] == s[right];
+        }
+        if (!same) {
+            name++;
+        }
+        reduced[lmsIndex[sortedLms[i]]] = name;
+    }
+
+    std::vector<int32_t> reducedSa = sais(reduced.data(), m, name);
+    for (int32_t i = 0; i < m; i++) {
+        sortedLms[i] = lms[reducedSa[i]];
+    }
+    induce(sortedLms);
+    return sa;
+}
+
+} // namespace suffix_array_detail
+
+/**
+ * @brief Indeks tekstu: tablica sufiksów, tablica LCP i kopia tekstu.
+ */
+class SuffixArrayIndex {
+public:
+    /// Nagłówek pliku indeksu; po nim tekst, tablica sufiksów i tablica LCP
+    struct Header {
+        char magic[8]; // "SAFILE1"
+        uint32_t endianCheck;
+        uint32_t reserved;
+        uint64_t textLength;
+        uint64_t suffixesOffset; // Tekst zaczyna się zaraz po nagłówku
+        uint64_t lcpOffset;
+        uint64_t fileSize;
+    };
+
+private:
+    static constexpr char MAGIC[8] = "SAFILE1";
+    static const uint32_t ENDIAN_CHECK = 0x01020304;
+
+    std::string text;
+    std::vector<int32_t> suffixes; ///< suffixes[i] - początek i-tego sufiksu w kolejności leksykograficznej
+    std::vector<int32_t> lcp;      ///< lcp[i] - wspólny prefiks sufiksów i-1 oraz i (lcp[0] = 0)
+
+    SuffixArrayIndex() = default;
+
+    static uint64_t alignTo8(uint64_t value) { return (value + 7) & ~(uint64_t)7; }
+
+    /// Algorytm Kasaia: sufiks zaczynający się o jeden znak dalej ma LCP mniejsze najwyżej o 1
+    void buildLCP() {
+        size_t n = text.size();
+        std::vector<int32_t> rank(n);
+        for (size_t i = 0; i < n; i++) {
+            rank[suffixes[i]] = (int32_t)i;
+        }
+        lcp.assign(n, 0);
+        size_t h = 0;
+        for (size_t position = 0; position < n; position++) {
+            if (rank[position] == 0) {
+                h = 0;
+                continue;
+            }
+            size_t previous = suffixes[rank[position] - 1];
+            while (position + h < n && previous + h < n && text[position + h] == text[previous + h]) {
+                h++;
+            }
+            lcp[rank[position]] = (int32_t)h;
+            if (h > 0) {
+                h--;
+            }
+        }
+    }
+
+    /**
+     * @brief Pierwszy sufiks (w kolejności tablicy) nie mniejszy od wzorca, a dla
+     *        @p upper - pierwszy, którego prefiks długości m jest większy od wzorca.
+     */
+    size_t bound(std::string_view pattern, bool upper) const {
+        size_t low = 0, high = suffixes.size();
+        size_t lcpLow = 0, lcpHigh = 0; // Zgodne znaki wzorca z sufiksem low - 1 i high
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            const char* suffix = text.data() + suffixes[middle];
+            size_t suffixLength = text.size() - suffixes[middle];
+            size_t k = std::min(lcpLow, lcpHigh);
+            while (k < pattern.size() && k < suffixLength && suffix[k] == pattern[k]) {
+                k++;
+            }
+            bool right;
+            if (k == pattern.size()) {
+                right = upper; // Wzorzec jest prefiksem sufiksu
+            } else if (k == suffixLength) {
+                right = true; // Sufiks jest właściwym prefiksem wzorca, więc jest mniejszy
+            } else {
+                right = (unsigned char)suffix[k] < (unsigned char)pattern[k];
+            }
+            if (right) {
+                low = middle + 1;
+                lcpLow = k;
+            } else {
+                high = middle;
+                lcpHigh = k;
+            }
+        }
+        return low;
+    }
+
+    static void writeAll(FILE* file, const void* data, size_t bytes, const std::string& path) {
+        if (bytes && fwrite(data, 1, bytes, file) != bytes) {
+            fclose(file);
+            throw std::runtime_error("SuffixArrayIndex: write failed: " + path);
+        }
+    }
+
+    static void readAll(FILE* file, void* data, size_t bytes, const std::string& path) {
+        if (bytes && fread(data, 1, bytes, file) != bytes) {
+            fclose(file);
+            throw std::runtime_error("SuffixArrayIndex: truncated index file: " + path);
+        }
+    }
+
+public:
+    /**
+     * @brief Buduje indeks: SA-IS i Kasai, oba O(n).
+     * @throws std::length_error gdy tekst ma 2^31 bajtów lub więcej
+     */
+    explicit SuffixArrayIndex(std::string text) : text(std::move(text)) {
+        if (this->text.size() > (size_t)INT32_MAX) {
+            throw std::length_error("SuffixArrayIndex: text exceeds 2 GB");
+        }
+        suffixes = suffix_array_detail::sais((const unsigned char*)this->text.data(),
+                                             (int32_t)this->text.size(), 255);
+        buildLCP();
+    }
+
+    size_t size() const { return text.size(); }
+    std::string_view view() const { return text; }
+    const std::vector<int32_t>& suffixArray() const { return suffixes; }
+    const std::vector<int32_t>& lcpArray() const { return lcp; }
+
+    /**
+     * @brief Przedział [first, last) tablicy sufiksów z sufiksami zaczynającymi się od wzorca.
+     */
+    std::pair<size_t, size_t> range(std::string_view pattern) const {
+        return {bound(pattern, false), bound(pattern, true)};
+    }
+
+    /**
+     * @brief Liczba wystąpień wzorca - O(m log n), bez przeglądania wystąpień.
+     */
+    size_t count(std::string_view pattern) const {
+        if (pattern.empty()) {
+            return 0; // Jak pozostałe algorytmy: pusty wzorzec niczego nie dopasowuje
+        }
+        auto [first, last] = range(pattern);
+        return last - first;
+    }
+
+    /**
+     * @brief Wywołuje onMatch(pozycja) dla każdego wystąpienia wzorca.
+     *
+     * Pozycje podawane są w kolejności tablicy sufiksów, nie rosnąco (posortuj je, jeśli
+     * kolejność ma znaczenie). Koniec przedziału wyznacza tablica LCP: kolejne sufiksy
+     * zaczynają się od wzorca, dopóki lcp[i] >= m.
+     */
+    template <typename OnMatch>
+    void locate(std::string_view pattern, OnMatch onMatch) const {
+        if (pattern.empty()) {
+            return;
+        }
+        size_t i = bound(pattern, false);
+        if (i == suffixes.size() || text.size() - suffixes[i] < pattern.size() ||
+            text.compare(suffixes[i], pattern.size(), pattern) != 0) {
+            return;
+        }
+        onMatch((size_t)suffixes[i]);
+        while (++i < suffixes.size() && (size_t)lcp[i] >= pattern.size()) {
+            onMatch((size_t)suffixes[i]);
+        }
+    }
+
+    /**
+     * @brief Zapisuje indeks do pliku: nagłówek, tekst, tablica sufiksów, tablica LCP
+     *        (little-endian, tablice wyrównane do 8 bajtów).
+     * @throws std::runtime_error gdy zapis się nie powiedzie
+     */
+    void save(const std::string& path) const {
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.endianCheck = ENDIAN_CHECK;
+        header.textLength = text.size();
+        header.suffixesOffset = alignTo8(sizeof(Header) + text.size());
+        header.lcpOffset = header.suffixesOffset + suffixes.size() * sizeof(int32_t);
+        header.lcpOffset = alignTo8(header.lcpOffset);
+        header.fileSize = header.lcpOffset + lcp.size() * sizeof(int32_t);
+
+        FILE* file = fopen(path.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("SuffixArrayIndex: cannot create " + path);
+        }
+        static const char padding[8] = {0};
+        uint64_t afterText = sizeof(Header) + text.size();
+        uint64_t afterSuffixes = header.suffixesOffset + suffixes.size() * sizeof(int32_t);
+        writeAll(file, &header, sizeof(header), path);
+        writeAll(file, text.data(), text.size(), path);
+        writeAll(file, padding, header.suffixesOffset - afterText, path);
+        writeAll(file, suffixes.data(), suffixes.size() * sizeof(int32_t), path);
+        writeAll(file, padding, header.lcpOffset - afterSuffixes, path);
+        writeAll(file, lcp.data(), lcp.size() * sizeof(int32_t), path);
+        if (fclose(file) != 0) {
+            throw std::runtime_error("SuffixArrayIndex: write failed: " + path);
+        }
+    }
+
+    /**
+     * @brief Wczytuje indeks zapisany przez \ref save - jeden odczyt sekwencyjny zamiast
+     *        budowania.
+     * @throws std::runtime_error gdy plik nie istnieje lub nie jest plikiem indeksu
+     */
+    static SuffixArrayIndex load(const std::string& path) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) {
+            throw std::runtime_error("SuffixArrayIndex: cannot open " + path);
+        }
+        Header header;
+        if (fread(&header, 1, sizeof(header), file) != sizeof(header) ||
+            memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.endianCheck != ENDIAN_CHECK ||
+            header.textLength > (uint64_t)INT32_MAX ||
+            header.suffixesOffset != alignTo8(sizeof(Header) + header.textLength) ||
+            header.lcpOffset !=
+                alignTo8(header.suffixesOffset + header.textLength * sizeof(int32_t)) ||
+            header.fileSize != header.lcpOffset + header.textLength * sizeof(int32_t)) {
+            fclose(file);
+            throw std::runtime_error("SuffixArrayIndex: not a suffix array file: " + path);
+        }
+        size_t n = (size_t)header.textLength;
+        char padding[8];
+        SuffixArrayIndex index;
+        index.text.resize(n);
+        index.suffixes.resize(n);
+        index.lcp.resize(n);
+        readAll(file, index.text.data(), n, path);
+        readAll(file, padding, header.suffixesOffset - sizeof(Header) - n, path);
+        readAll(file, index.suffixes.data(), n * sizeof(int32_t), path);
+        readAll(file, padding, header.lcpOffset - header.suffixesOffset - n * sizeof(int32_t),
+                path);
+        readAll(file, index.lcp.data(), n * sizeof(int32_t), path);
+        fclose(file);
+        for (int32_t start : index.suffixes) {
+            if (start < 0 || (size_t)start >= n) { // Zepsuty plik nie może dać odczytu poza tekstem
+                throw std::runtime_error("SuffixArrayIndex: corrupt suffix array: " + path);
+            }
+        }
+        return index;
+    }
+};